@@ -0,0 +1,55 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Animaciones sin bloqueo
+
+  Descripción:
+  Motor de animaciones por cuadros, guiado por millis(). Cada animación es
+  una función que dibuja UN cuadro y devuelve cuántos ms esperar hasta el
+  siguiente (o ANIM_FIN). El estado de la animación es solo el número de
+  cuadro, así que loop() nunca se queda esperando en delay().
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef ANIMADOR_H
+#define ANIMADOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+const uint16_t ANIM_FIN = 0xFFFF;
+
+// Dibuja el cuadro indicado y devuelve la espera en ms hasta el siguiente
+typedef uint16_t (*PasoAnimacion)(uint16_t cuadro);
+
+class Animador {
+public:
+    void iniciar(PasoAnimacion paso, uint32_t ahora) {
+        actual = paso;
+        cuadro = 0;
+        proximo = ahora;
+    }
+
+    void detener() { actual = NULL; }
+
+    bool activa() const { return actual != NULL; }
+    bool reproduciendo(PasoAnimacion paso) const { return actual == paso; }
+
+    // Dibuja como máximo un cuadro. Devuelve true si dibujó.
+    bool actualizar(uint32_t ahora) {
+        if (actual == NULL || (int32_t)(ahora - proximo) < 0) return false;
+        uint16_t espera = actual(cuadro++);
+        if (espera == ANIM_FIN) actual = NULL;
+        else proximo = ahora + espera;
+        return true;
+    }
+
+private:
+    PasoAnimacion actual = NULL;
+    uint16_t cuadro = 0;
+    uint32_t proximo = 0;
+};
+
+#endif
@@ -0,0 +1,101 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Tablas de calibración de motores
+
+  Descripción:
+  Una tabla de 256 entradas por motor y por sentido convierte la velocidad
+  pedida (0-255) en el duty que realmente produce esa velocidad en ese
+  motor: corrige la zona muerta, la curva no lineal duty/velocidad y la
+  diferencia entre motores con una sola consulta a memoria.
+  La entrada 0 siempre es 0 (detenido).
+
+  Las tablas se generan a partir de puntos medidos (duty, velocidad) con
+  generarTablaCalibracion(), que usan tanto el firmware como la herramienta
+  de PC (Herramientas/GenerarCalibracion.cpp).
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef CALIBRACION_H
+#define CALIBRACION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+const uint8_t CAL_MOTORES = 2;
+const uint8_t CAL_SENTIDOS = 2;   // 0 = adelante, 1 = atrás
+const uint8_t CAL_TABLAS = CAL_MOTORES * CAL_SENTIDOS;
+
+struct TablasCalibracion {
+    uint8_t tabla[CAL_TABLAS][256]; // Índice: motor * CAL_SENTIDOS + sentido
+};
+
+inline uint8_t indiceTabla(uint8_t motor, uint8_t sentido) {
+    return (uint8_t)(motor * CAL_SENTIDOS + sentido);
+}
+
+// Velocidad con signo (-255..255) -> duty con signo calibrado para el motor (0 o 1)
+inline int16_t aplicarCalibracion(const TablasCalibracion& t, uint8_t motor, int16_t velocidad) {
+    if (velocidad >= 0) return t.tabla[indiceTabla(motor, 0)][velocidad];
+    return -(int16_t)t.tabla[indiceTabla(motor, 1)][-velocidad];
+}
+
+// Fuerza la entrada 0 (detenido) de cada tabla a 0. Devuelve true si alguna no lo era:
+// las tablas llegan por Bluetooth o de la NVS y no se puede confiar en ellas.
+inline bool corregirEntradaCero(TablasCalibracion& t) {
+    bool corregida = false;
+    for (uint8_t i = 0; i < CAL_TABLAS; i++) {
+        if (t.tabla[i][0] != 0) corregida = true;
+        t.tabla[i][0] = 0;
+    }
+    return corregida;
+}
+
+// Tabla lineal con un desplazamiento fijo (la antigua 'compensation'), con signo y saturada
+inline void tablaCompensacion(uint8_t* tabla, int8_t compensacion) {
+    tabla[0] = 0;
+    for (int16_t v = 1; v < 256; v++) {
+        int16_t d = v + compensacion;
+        tabla[v] = (uint8_t)(d < 0 ? 0 : (d > 255 ? 255 : d));
+    }
+}
+
+struct PuntoCalibracion {
+    uint8_t duty;
+    uint16_t velocidad; // Medida con ese duty, en cualquier unidad (0 = no gira)
+};
+
+// Genera la tabla de un motor/sentido. 'puntos' ordenados por duty creciente,
+// con velocidad no decreciente. 'velocidadMax' es la velocidad que debe
+// corresponder a la entrada 255 (normalmente la menor de las máximas de todos
+// los motores, para que ambos lleguen a la misma velocidad tope).
+// Los puntos con velocidad 0 definen la zona muerta: cualquier entrada > 0
+// empieza justo por encima de ella.
+inline void generarTablaCalibracion(const PuntoCalibracion* puntos, uint8_t n, uint16_t velocidadMax, uint8_t* tabla) {
+    tabla[0] = 0;
+    for (uint16_t v = 1; v < 256; v++) {
+        uint32_t deseada = ((uint32_t)v * velocidadMax + 127) / 255;
+        if (deseada == 0) deseada = 1; // Fuera de la zona muerta
+        uint8_t duty = (n > 0) ? puntos[n - 1].duty : 255;
+
+        for (uint8_t i = 0; i < n; i++) {
+            if (puntos[i].velocidad < deseada) continue;
+            if (i == 0 || puntos[i].velocidad == puntos[i - 1].velocidad) {
+                duty = puntos[i].duty;
+            } else {
+                // Interpolación lineal entre el punto anterior y este
+                uint32_t v0 = puntos[i - 1].velocidad, v1 = puntos[i].velocidad;
+                uint32_t d0 = puntos[i - 1].duty, d1 = puntos[i].duty;
+                duty = (uint8_t)(d0 + ((d1 - d0) * (deseada - v0) + (v1 - v0) / 2) / (v1 - v0));
+                if (duty <= d0 && d1 > d0) duty = (uint8_t)(d0 + 1); // deseada > v0: salir de d0
+            }
+            break;
+        }
+        // Nunca devolver 0 para una velocidad pedida > 0
+        tabla[v] = duty > 0 ? duty : 1;
+    }
+}
+
+#endif
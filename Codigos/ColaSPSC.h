@@ -0,0 +1,85 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Cola sin bloqueo de un productor y un consumidor
+
+  Descripción:
+  Buffer circular de capacidad fija para pasar mensajes entre dos tareas
+  (p. ej. control -> pantalla) sin mutex ni secciones críticas: el productor
+  solo escribe 'cabeza' y el consumidor solo escribe 'cola'. Ninguna de las
+  dos operaciones espera; si la cola está llena, encolar() devuelve false.
+  encolarTodos()/desencolarVarios() pasan bloques (p. ej. bytes a enviar).
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef COLA_SPSC_H
+#define COLA_SPSC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// N debe ser potencia de 2; caben N - 1 elementos
+template <typename T, size_t N>
+class ColaSPSC {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    // Solo desde el productor
+    bool encolar(const T& valor) {
+        size_t cab = cabeza.load(std::memory_order_relaxed);
+        size_t siguiente = (cab + 1) & (N - 1);
+        if (siguiente == cola.load(std::memory_order_acquire)) return false; // Llena
+        buffer[cab] = valor;
+        cabeza.store(siguiente, std::memory_order_release);
+        return true;
+    }
+
+    // Solo desde el consumidor
+    bool desencolar(T& valor) {
+        size_t col = cola.load(std::memory_order_relaxed);
+        if (col == cabeza.load(std::memory_order_acquire)) return false; // Vacía
+        valor = buffer[col];
+        cola.store((col + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    // Solo desde el productor: encola los 'n' elementos o, si no caben todos, ninguno
+    // (un mensaje de varios bytes nunca queda cortado)
+    bool encolarTodos(const T* valores, size_t n) {
+        size_t cab = cabeza.load(std::memory_order_relaxed);
+        size_t libres = (cola.load(std::memory_order_acquire) - cab - 1) & (N - 1);
+        if (n > libres) return false;
+        for (size_t i = 0; i < n; i++) buffer[(cab + i) & (N - 1)] = valores[i];
+        cabeza.store((cab + n) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    // Solo desde el consumidor: hasta 'maximo' elementos en orden. Devuelve cuántos.
+    size_t desencolarVarios(T* destino, size_t maximo) {
+        size_t col = cola.load(std::memory_order_relaxed);
+        size_t disponibles = (cabeza.load(std::memory_order_acquire) - col) & (N - 1);
+        size_t n = disponibles < maximo ? disponibles : maximo;
+        for (size_t i = 0; i < n; i++) destino[i] = buffer[(col + i) & (N - 1)];
+        cola.store((col + n) & (N - 1), std::memory_order_release);
+        return n;
+    }
+
+    // Aproximado si se consulta mientras la otra tarea opera
+    size_t cantidad() const {
+        return (cabeza.load(std::memory_order_acquire) - cola.load(std::memory_order_acquire)) & (N - 1);
+    }
+
+    bool vacia() const { return cantidad() == 0; }
+
+    static size_t capacidad() { return N - 1; }
+
+private:
+    T buffer[N];
+    std::atomic<size_t> cabeza{0}; // Próxima posición a escribir
+    std::atomic<size_t> cola{0};   // Próxima posición a leer
+};
+
+#endif
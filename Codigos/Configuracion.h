@@ -0,0 +1,50 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Pines y parámetros del firmware
+
+  Descripción:
+  Los valores de principal.cpp que las pruebas de PC (Pruebas/) y las
+  herramientas también necesitan: pines de los motores, tiempos de las
+  tareas, timeouts, el límite de bytes por pasada y las esperas de la NVS.
+  Las pruebas incluyen este archivo en vez de copiar los números, así un
+  cambio en el firmware se prueba con el valor nuevo.
+  Son const de espacio de nombres: cada archivo que lo incluye tiene su
+  copia (sin enlace externo). No depende de Arduino.
+  ============================================================================
+*/
+
+#ifndef CONFIGURACION_H
+#define CONFIGURACION_H
+
+#include <stdint.h>
+
+// Configuración de motores (PWM en pines de dirección)
+#define M1_IN1_CHANNEL 4  // GPIO4 - Motor Derecho IN1
+#define M1_IN2_CHANNEL 2  // GPIO2 - Motor Derecho IN2
+#define M2_IN1_CHANNEL 27 // GPIO27 - Motor Izquierdo IN3
+#define M2_IN2_CHANNEL 26 // GPIO26 - Motor Izquierdo IN4
+
+// Canales que la ISR del vigilante pone a 0
+const uint8_t pinesMotores[] = { M1_IN1_CHANNEL, M1_IN2_CHANNEL, M2_IN1_CHANNEL, M2_IN2_CHANNEL };
+
+// Tareas: tick de control por timer de hardware; pantalla y fondo duermen entre pasadas
+const uint32_t frecuenciaControl = 1000; // Hz
+const uint32_t periodoUI = 5; // ms
+const uint32_t periodoFondo = 20; // ms
+
+const unsigned long commandTimeout = 700; // ms - Detener motores si no hay comandos en este tiempo
+
+// Vigilante: igual al timeout de comandos, para los clientes que no envían BYTE_VIDA;
+// los que sí pueden bajarlo a < 100 ms con TRAMA_VIGILANTE
+const uint16_t timeoutVigilanteInicial = commandTimeout; // ms
+
+// Modo agrupado: acota la duración de una pasada ante un flujo continuo
+const uint16_t bytesMaxPorPasada = 512;
+
+// NVS: la tarea de fondo escribe los cambios cuando dejan de llegar
+const uint32_t esperaNvs = 2000;     // ms sin cambios antes de escribir
+const uint32_t esperaMaxNvs = 10000; // ms como máximo desde el primer cambio pendiente
+
+#endif
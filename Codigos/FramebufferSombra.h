@@ -0,0 +1,76 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Copia sombra del framebuffer SSD1306
+
+  Descripción:
+  Guarda una copia de lo último enviado a la pantalla y, comparando con el
+  framebuffer actual, calcula por cada página (8 filas) el rango de columnas
+  que cambió. Así solo se envía por I2C lo necesario.
+  El framebuffer tiene el formato del SSD1306 / Adafruit_SSD1306: un byte por
+  columna y página, bit 0 arriba, páginas consecutivas de ANCHO bytes.
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef FRAMEBUFFER_SOMBRA_H
+#define FRAMEBUFFER_SOMBRA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+struct RangoPagina {
+    uint8_t pagina;
+    uint8_t colInicio; // Inclusive
+    uint8_t colFin;    // Inclusive
+};
+
+template <uint8_t ANCHO, uint8_t ALTO>
+class FramebufferSombra {
+public:
+    static const uint8_t PAGINAS = ALTO / 8;
+    static const size_t BYTES = (size_t)ANCHO * PAGINAS;
+
+    // Escribe en 'rangos' (capacidad PAGINAS) las regiones que difieren de la
+    // sombra y actualiza la sombra. Devuelve cuántos rangos hay.
+    uint8_t calcular(const uint8_t* buffer, RangoPagina* rangos) {
+        uint8_t n = 0;
+        for (uint8_t p = 0; p < PAGINAS; p++) {
+            const uint8_t* nueva = buffer + (size_t)p * ANCHO;
+            uint8_t* vieja = sombra + (size_t)p * ANCHO;
+            int16_t ini = -1, fin = -1;
+            if (!valida) {
+                ini = 0;
+                fin = ANCHO - 1;
+            } else {
+                for (uint8_t c = 0; c < ANCHO; c++) {
+                    if (nueva[c] != vieja[c]) {
+                        if (ini < 0) ini = c;
+                        fin = c;
+                    }
+                }
+            }
+            if (ini < 0) continue;
+            rangos[n].pagina = p;
+            rangos[n].colInicio = (uint8_t)ini;
+            rangos[n].colFin = (uint8_t)fin;
+            n++;
+            memcpy(vieja + ini, nueva + ini, (size_t)(fin - ini + 1));
+        }
+        valida = true;
+        return n;
+    }
+
+    // El contenido real de la pantalla es desconocido: el próximo envío es completo
+    void invalidar() { valida = false; }
+
+    const uint8_t* datos() const { return sombra; }
+
+private:
+    uint8_t sombra[BYTES];
+    bool valida = false;
+};
+
+#endif
@@ -0,0 +1,47 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Capa de abstracción de hardware (HAL)
+
+  Descripción:
+  Todo lo que principal.cpp necesita del hardware pasa por aquí, para poder
+  compilar la misma lógica de control en el ESP32 y en el PC (simulador en
+  Herramientas/Simulador.cpp).
+
+  Interfaz (namespace hal):
+  - millis(), micros(): reloj. En el PC es un reloj simulado.
+  - ciclos(), ciclosPorUs(): contador de ciclos de CPU (en el PC, ns reales).
+  - pwmAdjuntar(pin, frecuencia, resolucion), pwmEscribir(pin, duty): LEDC.
+    En el PC cada escritura queda registrada con su marca de tiempo. Están
+    en HalPwm.h, que se puede incluir solo (Motor.h).
+  - crearTarea(funcion, nombre, pila, prioridad, nucleo): tarea FreeRTOS fija
+    a un núcleo. En el PC no hace nada: el simulador llama a los pasos.
+  - iniciarTick(hz), esperarTick(timeoutMs): tick de control por timer de
+    hardware, para la tarea que llama a iniciarTick().
+  - dormirMs(ms), terminarLoop().
+  - iniciarVigilante(pines, cantidad, timeoutMs): vigilante (deadman) en un
+    timer de hardware propio. Si pasan timeoutMs sin alimentarVigilante(),
+    su ISR escribe duty 0 en los pines, sin depender de ninguna tarea, y lo
+    repite cada timeoutMs. fijarTimeoutVigilante(ms) lo cambia en marcha;
+    vigilanteDisparado() indica (y borra) si expiró desde la última
+    alimentación. En el PC el simulador llama a simularVigilante().
+  - EnlaceBT: Transporte (Transporte.h) de los comandos: BluetoothSerial;
+    en el PC, cola del simulador o socket UDP. Solo en el PC hay además
+    TransporteSocket (socket Unix).
+  - Pantalla<ANCHO, ALTO>: SSD1306 (framebuffer en memoria en el PC).
+  Además quedan disponibles Serial, Preferences, random() y las constantes
+  SSD1306_* con la misma API de Arduino.
+  ============================================================================
+*/
+
+#ifndef HAL_H
+#define HAL_H
+
+#if defined(ARDUINO)
+#include "HalEsp32.h"
+#else
+#include "HalHost.h"
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - HAL para ESP32 (ver Hal.h)
+  ============================================================================
+*/
+
+#ifndef HAL_ESP32_H
+#define HAL_ESP32_H
+
+#include <Arduino.h>
+#include <BluetoothSerial.h>
+#include <Preferences.h>
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "HalPwm.h"
+#include "PantallaDiferencial.h"
+#include "Transporte.h"
+
+namespace hal {
+
+class EnlaceBT : public Transporte {
+public:
+    bool begin(const char* nombre) override { return bt.begin(nombre); }
+    bool connected() override { return bt.connected(); }
+    int available() override { return bt.available(); }
+    int read() override { return bt.read(); }
+    size_t write(const uint8_t* datos, size_t largo) override { return bt.write(datos, largo); }
+
+private:
+    BluetoothSerial bt;
+};
+
+template <uint8_t ANCHO, uint8_t ALTO>
+class Pantalla : public PantallaDiferencial<ANCHO, ALTO> {
+public:
+    Pantalla() : PantallaDiferencial<ANCHO, ALTO>(&Wire, -1) {}
+};
+
+inline uint32_t millis() { return ::millis(); }
+inline uint32_t micros() { return ::micros(); }
+inline uint32_t ciclos() { return ESP.getCycleCount(); }
+inline uint32_t ciclosPorUs() { return getCpuFrequencyMhz(); }
+
+inline void crearTarea(void (*funcion)(void*), const char* nombre, uint32_t pila, uint8_t prioridad, uint8_t nucleo) {
+    xTaskCreatePinnedToCore(funcion, nombre, pila, NULL, prioridad, NULL, nucleo);
+}
+
+static TaskHandle_t tareaTick = NULL;
+
+static void IRAM_ATTR isrTick() {
+    BaseType_t despertar = pdFALSE;
+    vTaskNotifyGiveFromISR(tareaTick, &despertar);
+    portYIELD_FROM_ISR(despertar);
+}
+
+// Llamar desde la tarea que debe despertarse en cada tick
+inline void iniciarTick(uint32_t hz) {
+    tareaTick = xTaskGetCurrentTaskHandle();
+    hw_timer_t* timer = timerBegin(1000000); // 1 MHz
+    timerAttachInterrupt(timer, &isrTick);
+    timerAlarm(timer, 1000000 / hz, true, 0);
+}
+
+// El timeout evita quedarse parado si el timer no arranca
+inline void esperarTick(uint32_t timeoutMs) { ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs)); }
+
+inline void dormirMs(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+
+static hw_timer_t* timerVigilante = NULL;
+static const uint8_t* pinesVigilante = NULL;
+static uint8_t cantidadPinesVigilante = 0;
+static volatile bool vigilanteExpiro = false;
+
+// Sin IRAM_ATTR a propósito: ledcWrite() está en flash, y así la ISR queda
+// en espera (no falla) mientras se escribe la NVS
+static void isrVigilante() {
+    for (uint8_t i = 0; i < cantidadPinesVigilante; i++) ledcWrite(pinesVigilante[i], 0);
+    vigilanteExpiro = true;
+}
+
+inline void fijarTimeoutVigilante(uint32_t timeoutMs) {
+    timerAlarm(timerVigilante, (uint64_t)timeoutMs * 1000, true, 0); // Se repite hasta que lo alimenten
+    timerWrite(timerVigilante, 0);
+}
+
+inline void iniciarVigilante(const uint8_t* pines, uint8_t cantidad, uint32_t timeoutMs) {
+    pinesVigilante = pines;
+    cantidadPinesVigilante = cantidad;
+    timerVigilante = timerBegin(1000000); // 1 MHz
+    timerAttachInterrupt(timerVigilante, &isrVigilante);
+    fijarTimeoutVigilante(timeoutMs);
+}
+
+// No borra vigilanteExpiro: un comando que llega en el mismo tick que la expiración
+// no debe ocultarla, o la tarea de control no sabría que el PWM ya está en 0
+inline void alimentarVigilante() { timerWrite(timerVigilante, 0); }
+
+inline bool vigilanteDisparado() {
+    if (!vigilanteExpiro) return false;
+    vigilanteExpiro = false;
+    return true;
+}
+
+// loop() no se usa: todo el trabajo ocurre en las tareas
+inline void terminarLoop() { vTaskDelete(NULL); }
+
+}
+
+#endif
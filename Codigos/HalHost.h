@@ -0,0 +1,434 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - HAL para PC / simulador (ver Hal.h)
+
+  Descripción:
+  Reemplazos en memoria del hardware del robot:
+  - Reloj simulado: lo avanza el simulador (hal::relojUs).
+  - PWM: cada escritura se guarda en hal::registroPwm con su marca de tiempo.
+  - EnlaceBT: cola de bytes que el simulador llena con inyectar() o que se
+    alimenta de un socket UDP (escucharUdp()).
+  - TransporteSocket: socket Unix de flujo (escuchar() en una ruta o
+    adoptar() un extremo de socketpair()). Conectado mientras haya cliente.
+  - Pantalla: framebuffer en memoria con el mismo formato del SSD1306. Las
+    primitivas gráficas se dibujan; el texto usa celdas de 6x8 como
+    Adafruit_GFX con un glifo de relleno (no la fuente real).
+  - Preferences: almacenamiento en memoria.
+  Solo para Linux/macOS.
+  ============================================================================
+*/
+
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "FramebufferSombra.h"
+#include "HalPwm.h"
+#include "Transporte.h"
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_SWITCHCAPVCC 0x02
+
+inline long random(long minimo, long maximo) {
+    return maximo > minimo ? minimo + rand() % (maximo - minimo) : minimo;
+}
+
+// Serial: a stderr, se puede silenciar con Serial.activa = false
+class ConsolaHost {
+public:
+    bool activa = true;
+
+    void begin(unsigned long) {}
+
+    size_t print(const char* s) { return activa ? (size_t)fputs(s, stderr) : 0; }
+    size_t print(char c) { return activa ? (size_t)fputc(c, stderr) : 0; }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, size_t>::type print(T v) {
+        return activa ? (size_t)fprintf(stderr, "%lld", (long long)v) : 0;
+    }
+    size_t println() { return print('\n'); }
+    template <typename T>
+    size_t println(T v) { return print(v) + println(); }
+};
+
+inline ConsolaHost Serial;
+
+class Preferences {
+public:
+    bool begin(const char*, bool = false) { return true; }
+    void end() {}
+    size_t getBytesLength(const char* clave) {
+        auto it = datos.find(clave);
+        return it == datos.end() ? 0 : it->second.size();
+    }
+    size_t getBytes(const char* clave, void* destino, size_t largo) {
+        auto it = datos.find(clave);
+        if (it == datos.end() || it->second.size() > largo) return 0;
+        memcpy(destino, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+    size_t putBytes(const char* clave, const void* origen, size_t largo) {
+        const uint8_t* p = (const uint8_t*)origen;
+        datos[clave].assign(p, p + largo);
+        return largo;
+    }
+    bool remove(const char* clave) { return datos.erase(clave) > 0; }
+
+private:
+    std::map<std::string, std::vector<uint8_t> > datos;
+};
+
+namespace hal {
+
+// ---------------------------------------------------------------------------
+// Reloj y PWM
+// ---------------------------------------------------------------------------
+
+// relojUs y el registro del PWM están en HalPwm.h
+inline uint32_t millis() { return (uint32_t)(relojUs / 1000); }
+inline uint32_t micros() { return (uint32_t)relojUs; }
+
+// Contador de "ciclos": nanosegundos reales, para medir el costo del código en el PC
+inline uint32_t ciclos() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline uint32_t ciclosPorUs() { return 1000; }
+
+// ---------------------------------------------------------------------------
+// Tareas y tick: el simulador llama directamente a los pasos de cada tarea
+// ---------------------------------------------------------------------------
+
+inline void crearTarea(void (*)(void*), const char*, uint32_t, uint8_t, uint8_t) {}
+inline void iniciarTick(uint32_t) {}
+inline void esperarTick(uint32_t) {}
+inline void dormirMs(uint32_t) {}
+inline void terminarLoop() {}
+
+// ---------------------------------------------------------------------------
+// Vigilante: el simulador llama a simularVigilante() en cada avance del reloj
+// ---------------------------------------------------------------------------
+
+inline const uint8_t* pinesVigilante = NULL;
+inline uint8_t cantidadPinesVigilante = 0;
+inline uint64_t timeoutVigilanteUs = 0;
+inline uint64_t ultimoAlimentoUs = 0;
+inline bool vigilanteExpiro = false;
+inline std::vector<uint64_t> disparosVigilante; // Solo simulador: instantes de cada expiración
+
+inline void fijarTimeoutVigilante(uint32_t timeoutMs) {
+    timeoutVigilanteUs = (uint64_t)timeoutMs * 1000;
+    ultimoAlimentoUs = relojUs;
+}
+
+inline void iniciarVigilante(const uint8_t* pines, uint8_t cantidad, uint32_t timeoutMs) {
+    pinesVigilante = pines;
+    cantidadPinesVigilante = cantidad;
+    fijarTimeoutVigilante(timeoutMs);
+}
+
+// Como en el ESP32, solo vigilanteDisparado() borra la expiración
+inline void alimentarVigilante() { ultimoAlimentoUs = relojUs; }
+
+inline bool vigilanteDisparado() {
+    bool expiro = vigilanteExpiro;
+    vigilanteExpiro = false;
+    return expiro;
+}
+
+// Equivale a la ISR del timer: expira y se recarga cada timeout sin alimento
+inline void simularVigilante() {
+    if (timeoutVigilanteUs == 0 || relojUs - ultimoAlimentoUs < timeoutVigilanteUs) return;
+    for (uint8_t i = 0; i < cantidadPinesVigilante; i++) pwmEscribir(pinesVigilante[i], 0);
+    ultimoAlimentoUs = relojUs;
+    vigilanteExpiro = true;
+    disparosVigilante.push_back(relojUs);
+}
+
+// ---------------------------------------------------------------------------
+// Enlace de comandos
+// ---------------------------------------------------------------------------
+
+class EnlaceBT : public Transporte {
+public:
+    ~EnlaceBT() { if (sock >= 0) close(sock); }
+
+    bool begin(const char*) override { return true; }
+
+    // Recibe los comandos por UDP en 'puerto'; las respuestas van al último remitente
+    bool escucharUdp(uint16_t puerto) {
+        sock = socket(AF_INET, SOCK_DGRAM, 0);
+        if (sock < 0) return false;
+        sockaddr_in dir;
+        memset(&dir, 0, sizeof(dir));
+        dir.sin_family = AF_INET;
+        dir.sin_addr.s_addr = htonl(INADDR_ANY);
+        dir.sin_port = htons(puerto);
+        if (bind(sock, (sockaddr*)&dir, sizeof(dir)) < 0) { close(sock); sock = -1; return false; }
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+        return true;
+    }
+
+    bool connected() override { return conectado; }
+
+    int available() override {
+        recibirUdp();
+        return (int)entrada.size();
+    }
+
+    int read() override {
+        recibirUdp();
+        if (entrada.empty()) return -1;
+        uint8_t c = entrada.front();
+        entrada.pop_front();
+        return c;
+    }
+
+    size_t write(const uint8_t* datos, size_t largo) override {
+        salida.insert(salida.end(), datos, datos + largo);
+        if (sock >= 0 && hayPar) sendto(sock, datos, largo, 0, (sockaddr*)&par, sizeof(par));
+        return largo;
+    }
+
+    // Solo simulador
+    void conectar(bool estado) { conectado = estado; }
+    void inyectar(const uint8_t* datos, size_t largo) { entrada.insert(entrada.end(), datos, datos + largo); }
+    std::vector<uint8_t> salida; // Todo lo que el robot envió
+
+private:
+    void recibirUdp() {
+        if (sock < 0) return;
+        uint8_t buffer[512];
+        socklen_t largoPar = sizeof(par);
+        ssize_t n;
+        while ((n = recvfrom(sock, buffer, sizeof(buffer), 0, (sockaddr*)&par, &largoPar)) > 0) {
+            hayPar = true;
+            conectado = true; // El primer datagrama "conecta" al cliente
+            entrada.insert(entrada.end(), buffer, buffer + n);
+        }
+    }
+
+    std::deque<uint8_t> entrada;
+    bool conectado = false;
+    int sock = -1;
+    sockaddr_in par;
+    bool hayPar = false;
+};
+
+// Socket Unix de flujo, sin bloqueo. Un cliente a la vez; al cerrarse queda desconectado.
+class TransporteSocket : public Transporte {
+public:
+    ~TransporteSocket() {
+        cerrarCliente();
+        if (escucha >= 0) close(escucha);
+    }
+
+    bool begin(const char*) override { return true; }
+
+    // Acepta clientes en 'ruta' (se borra si ya existía)
+    bool escuchar(const char* ruta) {
+        sockaddr_un dir;
+        if (strlen(ruta) >= sizeof(dir.sun_path)) return false;
+        escucha = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (escucha < 0) return false;
+        memset(&dir, 0, sizeof(dir));
+        dir.sun_family = AF_UNIX;
+        strcpy(dir.sun_path, ruta);
+        unlink(ruta);
+        if (bind(escucha, (sockaddr*)&dir, sizeof(dir)) < 0 || listen(escucha, 1) < 0) {
+            close(escucha);
+            escucha = -1;
+            return false;
+        }
+        sinBloqueo(escucha);
+        return true;
+    }
+
+    // Usa un socket ya conectado (p. ej. un extremo de socketpair()); pasa a ser de este objeto
+    void adoptar(int fd) {
+        cerrarCliente();
+        cliente = fd;
+        sinBloqueo(cliente);
+    }
+
+    bool connected() override {
+        aceptar();
+        recibir(); // Detecta el cierre del cliente
+        return cliente >= 0 || !entrada.empty();
+    }
+
+    int available() override {
+        recibir();
+        return (int)entrada.size();
+    }
+
+    int read() override {
+        recibir();
+        if (entrada.empty()) return -1;
+        uint8_t c = entrada.front();
+        entrada.pop_front();
+        return c;
+    }
+
+    // Si el cliente no lee, lo que no cabe en el socket se descarta (como un enlace saturado)
+    size_t write(const uint8_t* datos, size_t largo) override {
+        if (cliente < 0) return 0;
+        ssize_t n = send(cliente, datos, largo, MSG_NOSIGNAL);
+        return n < 0 ? 0 : (size_t)n;
+    }
+
+private:
+    static void sinBloqueo(int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
+
+    void aceptar() {
+        if (escucha < 0 || cliente >= 0) return;
+        int fd = accept(escucha, NULL, NULL);
+        if (fd >= 0) adoptar(fd);
+    }
+
+    // Solo con la cola vacía: así available()/read() por byte no hacen una llamada al sistema cada uno
+    void recibir() {
+        if (cliente < 0 || !entrada.empty()) return;
+        uint8_t buffer[4096];
+        ssize_t n;
+        while ((n = recv(cliente, buffer, sizeof(buffer), 0)) > 0) entrada.insert(entrada.end(), buffer, buffer + n);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) cerrarCliente();
+    }
+
+    void cerrarCliente() {
+        if (cliente >= 0) close(cliente);
+        cliente = -1;
+    }
+
+    std::deque<uint8_t> entrada; // Lo ya recibido se entrega aunque el cliente haya cerrado
+    int escucha = -1;
+    int cliente = -1;
+};
+
+// ---------------------------------------------------------------------------
+// Pantalla
+// ---------------------------------------------------------------------------
+
+template <uint8_t ANCHO, uint8_t ALTO>
+class Pantalla {
+public:
+    bool begin(uint8_t, uint8_t) { return true; }
+
+    uint8_t* getBuffer() { return buffer; }
+    void clearDisplay() { memset(buffer, 0, sizeof(buffer)); }
+
+    // Copia el framebuffer a 'visible' y cuenta los bytes que se enviarían por I2C
+    void display() {
+        RangoPagina rangos[ALTO / 8];
+        uint8_t n = sombra.calcular(buffer, rangos);
+        bytesUltimoEnvio = 0;
+        for (uint8_t i = 0; i < n; i++) bytesUltimoEnvio += rangos[i].colFin - rangos[i].colInicio + 1;
+        bytesEnviados += bytesUltimoEnvio;
+        envios++;
+        memcpy(visible, buffer, sizeof(buffer));
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (x < 0 || x >= ANCHO || y < 0 || y >= ALTO) return;
+        uint8_t& b = buffer[(y / 8) * ANCHO + x];
+        if (color) b |= (uint8_t)(1 << (y & 7));
+        else b &= (uint8_t)~(1 << (y & 7));
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        for (int16_t j = y; j < y + h; j++)
+            for (int16_t i = x; i < x + w; i++) drawPixel(i, j, color);
+    }
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        fillRect(x, y, w, 1, color);
+        fillRect(x, y + h - 1, w, 1, color);
+        fillRect(x, y, 1, h, color);
+        fillRect(x + w - 1, y, 1, h, color);
+    }
+
+    // Texto: celdas de 6x8 por carácter como Adafruit_GFX. Cada carácter se
+    // dibuja con un patrón de 5x7 propio de su código (no la fuente real), para
+    // que el envío diferencial vea las mismas columnas que con el firmware.
+    void setTextSize(uint8_t s) { tamanoTexto = s; }
+    void setTextColor(uint16_t) {}
+    void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+
+    void getTextBounds(const char* s, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+        *x1 = x;
+        *y1 = y;
+        *w = (uint16_t)(strlen(s) * 6 * tamanoTexto);
+        *h = (uint16_t)(8 * tamanoTexto);
+    }
+
+    size_t print(const char* s) {
+        size_t n = strlen(s);
+        for (size_t i = 0; i < n; i++) {
+            uint8_t c = (uint8_t)s[i];
+            for (uint8_t col = 0; c != ' ' && col < 5; col++) {
+                uint8_t bits = (uint8_t)((((c * 37u + col * 11u) ^ (c >> 2)) | 0x41) & 0x7F);
+                for (uint8_t fila = 0; fila < 7; fila++) {
+                    if (bits & (1 << fila)) {
+                        fillRect(cursorX + col * tamanoTexto, cursorY + fila * tamanoTexto, tamanoTexto, tamanoTexto,
+                                 SSD1306_WHITE);
+                    }
+                }
+            }
+            cursorX += (int16_t)(6 * tamanoTexto);
+        }
+        return n;
+    }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, size_t>::type print(T v) {
+        char texto[24];
+        snprintf(texto, sizeof(texto), "%lld", (long long)v);
+        return print(texto);
+    }
+    size_t println(const char* s) {
+        size_t n = print(s);
+        cursorX = 0;
+        cursorY += 8 * tamanoTexto;
+        return n;
+    }
+
+    // Solo simulador
+    uint8_t visible[ANCHO * ALTO / 8] = {};
+    uint32_t envios = 0;
+    uint32_t bytesUltimoEnvio = 0;
+    uint64_t bytesEnviados = 0;
+
+private:
+    uint8_t buffer[ANCHO * ALTO / 8] = {};
+    FramebufferSombra<ANCHO, ALTO> sombra;
+    uint8_t tamanoTexto = 1;
+    int16_t cursorX = 0, cursorY = 0;
+};
+
+}
+
+#endif
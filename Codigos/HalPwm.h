@@ -0,0 +1,66 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - HAL del PWM (parte de Hal.h)
+
+  Descripción:
+  Solo pwmAdjuntar(pin, frecuencia, resolucion) y pwmEscribir(pin, duty),
+  para lo que no necesita el resto de la HAL (Motor.h): en el ESP32 no
+  arrastra BluetoothSerial, Preferences ni el SSD1306, y PruebaDeMotores
+  compila sin esas bibliotecas.
+  - ESP32: LEDC (ledcAttach/ledcWrite).
+  - PC: cada escritura queda en hal::registroPwm con la marca de tiempo del
+    reloj simulado (hal::relojUs, que también usa HalHost.h).
+  ============================================================================
+*/
+
+#ifndef HAL_PWM_H
+#define HAL_PWM_H
+
+#include <stdint.h>
+
+#if defined(ARDUINO)
+
+#include <Arduino.h>
+
+namespace hal {
+
+inline void pwmAdjuntar(uint8_t pin, uint32_t frecuencia, uint8_t resolucion) {
+    ledcAttach(pin, frecuencia, resolucion);
+}
+
+inline void pwmEscribir(uint8_t pin, uint32_t duty) { ledcWrite(pin, duty); }
+
+}
+
+#else
+
+#include <map>
+#include <vector>
+
+namespace hal {
+
+inline uint64_t relojUs = 0; // Lo avanza el simulador
+
+struct EscrituraPwm {
+    uint64_t us;
+    uint8_t pin;
+    uint32_t duty;
+};
+
+inline std::vector<EscrituraPwm> registroPwm;
+inline std::map<uint8_t, uint32_t> dutyPwm; // Último duty por pin
+
+inline void pwmAdjuntar(uint8_t pin, uint32_t, uint8_t) { dutyPwm[pin] = 0; }
+
+inline void pwmEscribir(uint8_t pin, uint32_t duty) {
+    dutyPwm[pin] = duty;
+    registroPwm.push_back(EscrituraPwm{ relojUs, pin, duty });
+}
+
+}
+
+#endif
+
+#endif
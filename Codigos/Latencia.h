@@ -0,0 +1,101 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Medición de latencias
+
+  Descripción:
+  Histogramas de tamaño fijo con cubetas logarítmicas (4 subcubetas por
+  potencia de 2, error < 25%) para registrar duraciones en ciclos de CPU sin
+  memoria dinámica. Cada histograma tiene un único escritor; el reinicio se
+  pide desde cualquier tarea y lo aplica el escritor en su próximo registro.
+
+  Las sondas SONDA_INICIO/SONDA_FIN solo generan código si MEDIR_LATENCIA
+  vale 1 (definirlo antes de incluir este archivo). Con 0 desaparecen por
+  completo, igual que los histogramas de latencias[].
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include <stdint.h>
+#include <atomic>
+
+class Histograma {
+public:
+    static const uint8_t SUBCUBETAS = 4;
+    static const uint8_t CUBETAS = (32 - 1) * SUBCUBETAS; // Valores 0..2^32-1
+
+    Histograma() { borrar(); }
+
+    void registrar(uint32_t valor) {
+        if (reinicioPedido.load(std::memory_order_acquire)) borrar();
+        cuentas[indice(valor)]++;
+        total++;
+        if (valor > maximo) maximo = valor;
+    }
+
+    // Seguro desde otra tarea: se aplica en el siguiente registrar()
+    void pedirReinicio() { reinicioPedido.store(true, std::memory_order_release); }
+
+    uint32_t cantidad() const { return total; }
+    uint32_t maximoValor() const { return maximo; }
+
+    // Límite superior de la cubeta que contiene el percentil p (0-100), acotado por el máximo
+    uint32_t percentil(uint8_t p) const {
+        if (total == 0) return 0;
+        uint32_t rango = (uint32_t)(((uint64_t)total * p + 99) / 100);
+        if (rango == 0) rango = 1;
+        uint32_t acumulado = 0;
+        for (uint8_t i = 0; i < CUBETAS; i++) {
+            acumulado += cuentas[i];
+            if (acumulado >= rango) return limiteSuperior(i) < maximo ? limiteSuperior(i) : maximo;
+        }
+        return maximo;
+    }
+
+    // 0..3 exactos; luego 4 cubetas por cada potencia de 2
+    static uint8_t indice(uint32_t v) {
+        if (v < SUBCUBETAS) return (uint8_t)v;
+        uint8_t msb = (uint8_t)(31 - __builtin_clz(v));
+        return (uint8_t)((msb - 1) * SUBCUBETAS + ((v >> (msb - 2)) & (SUBCUBETAS - 1)));
+    }
+
+    static uint32_t limiteSuperior(uint8_t i) {
+        if (i < SUBCUBETAS) return i;
+        uint8_t msb = (uint8_t)(i / SUBCUBETAS + 1);
+        uint32_t ancho = (uint32_t)1 << (msb - 2);
+        return (uint32_t)((SUBCUBETAS + i % SUBCUBETAS) * (uint64_t)ancho + ancho - 1);
+    }
+
+private:
+    void borrar() {
+        for (uint8_t i = 0; i < CUBETAS; i++) cuentas[i] = 0;
+        total = 0;
+        maximo = 0;
+        reinicioPedido.store(false, std::memory_order_relaxed);
+    }
+
+    uint32_t cuentas[CUBETAS];
+    uint32_t total;
+    uint32_t maximo;
+    std::atomic<bool> reinicioPedido;
+};
+
+#ifndef MEDIR_LATENCIA
+#define MEDIR_LATENCIA 0
+#endif
+
+#if MEDIR_LATENCIA
+#define SONDA_INICIO(t) uint32_t t = hal::ciclos()
+#define SONDA_FIN(etapa, t) latencias[etapa].registrar(hal::ciclos() - (t))
+#define SONDA_REGISTRAR(etapa, valor) latencias[etapa].registrar(valor)
+#else
+#define SONDA_INICIO(t) do {} while (0)
+#define SONDA_FIN(etapa, t) do {} while (0)
+#define SONDA_REGISTRAR(etapa, valor) do {} while (0)
+#endif
+
+#endif
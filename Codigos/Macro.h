@@ -0,0 +1,154 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Macros de manejo (grabar y reproducir)
+
+  Descripción:
+  Una macro es una lista de consignas con marca de tiempo: a los 'ms' desde
+  el inicio, velocidad con signo de cada rueda (-255..255, antes de la
+  calibración). Ocupa 6 bytes por paso.
+  - GrabadorMacro: guarda cada cambio de consigna que producen los comandos
+    del piloto. El tiempo cuenta desde la primera; varias en el mismo ms
+    ocupan un solo paso y, si la última no es una parada, se agrega una.
+  - ReproductorMacro: el tick de control llama a paso(), que entrega las
+    consignas cuyo tiempo ya llegó. Un paso sale en el primer tick en que su
+    tiempo se cumple (desviación <= 1 tick si el tick no se atrasa); la
+    mayor desviación queda en desviacionMaxMs().
+  bytesMacro() da el tamaño a guardar en NVS (solo los pasos usados).
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef MACRO_H
+#define MACRO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+const uint8_t MACROS_MAX = 4;
+const uint8_t MACRO_PASOS_MAX = 32;
+
+struct PasoMacro {
+    uint16_t ms;     // Desde el inicio de la macro
+    int16_t duty1;   // Motor 1 (derecho)
+    int16_t duty2;   // Motor 2 (izquierdo)
+};
+
+struct Macro {
+    uint8_t cantidad;
+    PasoMacro pasos[MACRO_PASOS_MAX];
+};
+
+inline size_t bytesMacro(const Macro& m) {
+    return offsetof(Macro, pasos) + (size_t)m.cantidad * sizeof(PasoMacro);
+}
+
+// Tamaño leído de NVS coherente con su propio contador de pasos
+inline bool macroValida(const Macro& m, size_t bytes) {
+    if (m.cantidad > MACRO_PASOS_MAX || bytes != bytesMacro(m)) return false;
+    for (uint8_t i = 1; i < m.cantidad; i++) {
+        if (m.pasos[i].ms < m.pasos[i - 1].ms) return false;
+    }
+    return true;
+}
+
+class GrabadorMacro {
+public:
+    void iniciar() {
+        macro.cantidad = 0;
+        grabando = true;
+        lleno = false;
+    }
+
+    // Nueva consigna del piloto. Si repite la anterior no ocupa un paso.
+    void agregar(uint32_t ahoraMs, int16_t duty1, int16_t duty2) {
+        if (!grabando) return;
+        uint8_t n = macro.cantidad;
+        if (n > 0 && macro.pasos[n - 1].duty1 == duty1 && macro.pasos[n - 1].duty2 == duty2) return;
+        if (n == 0) inicio = ahoraMs;
+        uint32_t t = ahoraMs - inicio;
+        if (n > 0 && macro.pasos[n - 1].ms == t) { // Misma pasada: gana la última
+            macro.pasos[n - 1].duty1 = duty1;
+            macro.pasos[n - 1].duty2 = duty2;
+            return;
+        }
+        // Reservar el último paso para la parada de terminar()
+        if (n >= MACRO_PASOS_MAX - 1 || t > 0xFFFF) { lleno = true; return; }
+        macro.pasos[n].ms = (uint16_t)t;
+        macro.pasos[n].duty1 = duty1;
+        macro.pasos[n].duty2 = duty2;
+        macro.cantidad++;
+    }
+
+    // Cierra la grabación con una parada. Devuelve false si no hubo consignas.
+    bool terminar(uint32_t ahoraMs, Macro& destino) {
+        if (!grabando) return false;
+        grabando = false;
+        if (macro.cantidad == 0) return false;
+        uint32_t t = ahoraMs - inicio;
+        const PasoMacro& ultimoPaso = macro.pasos[macro.cantidad - 1];
+        if (ultimoPaso.duty1 == 0 && ultimoPaso.duty2 == 0) { // Ya termina parado
+            destino = macro;
+            return true;
+        }
+        uint16_t ultimo = ultimoPaso.ms;
+        PasoMacro& fin = macro.pasos[macro.cantidad++];
+        fin.ms = (lleno || t > 0xFFFF) ? ultimo : (uint16_t)t;
+        fin.duty1 = fin.duty2 = 0;
+        destino = macro;
+        return true;
+    }
+
+    bool activo() const { return grabando; }
+    bool incompleta() const { return lleno; } // Se descartaron consignas por falta de espacio
+
+private:
+    Macro macro = {};
+    uint32_t inicio = 0;
+    bool grabando = false;
+    bool lleno = false;
+};
+
+class ReproductorMacro {
+public:
+    void iniciar(const Macro& m, uint32_t ahoraMs) {
+        macro = &m;
+        inicio = ahoraMs;
+        siguiente = 0;
+    }
+
+    // Próxima consigna vencida en este tick (la más reciente si se juntaron varias).
+    // Devuelve false si no hay nada que aplicar.
+    bool paso(uint32_t ahoraMs, int16_t& duty1, int16_t& duty2) {
+        if (!activo()) return false;
+        uint32_t t = ahoraMs - inicio;
+        bool hay = false;
+        while (siguiente < macro->cantidad && macro->pasos[siguiente].ms <= t) {
+            const PasoMacro& p = macro->pasos[siguiente++];
+            uint32_t desviacion = t - p.ms;
+            if (desviacion > desviacionMax) desviacionMax = desviacion;
+            pasosReproducidos++;
+            duty1 = p.duty1;
+            duty2 = p.duty2;
+            hay = true;
+        }
+        if (siguiente >= macro->cantidad) macro = NULL; // Último paso aplicado
+        return hay;
+    }
+
+    void cancelar() { macro = NULL; }
+    bool activo() const { return macro != NULL; }
+
+    uint32_t desviacionMaxMs() const { return desviacionMax; }
+    uint32_t reproducidos() const { return pasosReproducidos; }
+
+private:
+    const Macro* macro = NULL;
+    uint32_t inicio = 0;
+    uint8_t siguiente = 0;
+    uint32_t desviacionMax = 0;
+    uint32_t pasosReproducidos = 0;
+};
+
+#endif
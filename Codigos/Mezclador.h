@@ -0,0 +1,74 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Mezclador arcade (acelerador + giro -> duty por rueda)
+
+  Descripción:
+  Convierte un mando analógico de un solo stick (acelerador y giro, -127..127)
+  en duty con signo para cada rueda (-255..255), solo con enteros:
+  - Curva expo por eje: salida = (1 - e) * x + e * x^3, con e en Q8
+    (0 = lineal, 255 = casi cúbica). Da precisión cerca del centro.
+  - duty1 (derecho) = acelerador + giro, duty2 (izquierdo) = acelerador - giro.
+    Giro positivo gira como el comando 'R'.
+  - Saturación: si una rueda pasa de 255, ambas se escalan por el mismo
+    factor, así se conserva la relación entre ruedas (el radio de giro).
+  El manejo tipo tanque (un duty por rueda) es TRAMA_MANEJO.
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef MEZCLADOR_H
+#define MEZCLADOR_H
+
+#include <stdint.h>
+
+const int16_t MEZCLA_ENTRADA_MAX = 127;
+const int16_t MEZCLA_DUTY_MAX = 255;
+
+struct ConfigMezcla {
+    uint8_t expoAcelerador; // Q8: 0 lineal .. 255 casi cúbica
+    uint8_t expoGiro;
+};
+
+struct DutyRuedas {
+    int16_t duty1; // Motor 1 (derecho)
+    int16_t duty2; // Motor 2 (izquierdo)
+};
+
+// x en -127..127 (-128 se trata como -127) -> -255..255. Una sola división al
+// final (en 64 bits), redondeada: a <= 0,5 de la curva exacta.
+inline int16_t curvaExpo(int8_t x, uint8_t expo) {
+    int64_t v = x < -MEZCLA_ENTRADA_MAX ? -MEZCLA_ENTRADA_MAX : x;
+    const int64_t cuadrado = MEZCLA_ENTRADA_MAX * MEZCLA_ENTRADA_MAX;
+    int64_t num = ((256 - (int64_t)expo) * v * cuadrado + (int64_t)expo * v * v * v) * MEZCLA_DUTY_MAX;
+    const int64_t den = 256 * cuadrado * MEZCLA_ENTRADA_MAX;
+    return (int16_t)((num + (num >= 0 ? den / 2 : -den / 2)) / den); // Redondeo simétrico
+}
+
+// Escala 'v' por limite/mayor redondeando al más cercano (mayor > 0)
+inline int16_t escalarMezcla(int32_t v, int32_t mayor) {
+    int32_t p = v * MEZCLA_DUTY_MAX;
+    return (int16_t)((p + (p >= 0 ? mayor / 2 : -mayor / 2)) / mayor);
+}
+
+inline DutyRuedas mezclarArcade(int8_t acelerador, int8_t giro, const ConfigMezcla& c) {
+    int32_t a = curvaExpo(acelerador, c.expoAcelerador);
+    int32_t g = curvaExpo(giro, c.expoGiro);
+    int32_t d1 = a + g;
+    int32_t d2 = a - g;
+    int32_t mayor = d1 < 0 ? -d1 : d1;
+    int32_t abs2 = d2 < 0 ? -d2 : d2;
+    if (abs2 > mayor) mayor = abs2;
+    DutyRuedas r;
+    if (mayor > MEZCLA_DUTY_MAX) {
+        r.duty1 = escalarMezcla(d1, mayor);
+        r.duty2 = escalarMezcla(d2, mayor);
+    } else {
+        r.duty1 = (int16_t)d1;
+        r.duty2 = (int16_t)d2;
+    }
+    return r;
+}
+
+#endif
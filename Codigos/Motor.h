@@ -0,0 +1,144 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Motores DC con PWM en los pines de dirección
+
+  Descripción:
+  Motor<In1, In2, Rasgos>: pines, inversión y compensación se resuelven al
+  compilar; no hay ramas por motor ni por letra de dirección. La velocidad
+  pedida tiene signo (-255..255, positivo = adelante); la rampa de Rampa.h
+  la lleva al valor pedido tick a tick y en cada tick la compensación
+  convierte la velocidad de la rampa en duty (una consulta por tick). Así
+  la rampa es uniforme en velocidad real y atraviesa la zona muerta de un
+  salto, en vez de arrastrarse por duties que no mueven la rueda.
+  - RasgosMotor<invertido, Compensacion>: invertido intercambia In1/In2 (motor
+    montado al revés). Compensacion::aplicar(velocidad) devuelve el duty
+    real: SinCompensacion o CompensacionTabla<&tablas, motor> (Calibracion.h).
+  - DiffDrive<MotorDerecho, MotorIzquierdo>: calcula ambas rampas y luego
+    escribe los cuatro canales seguidos, para que las ruedas cambien juntas.
+  ============================================================================
+*/
+
+#ifndef MOTOR_H
+#define MOTOR_H
+
+#include <stdint.h>
+#include "HalPwm.h"
+#include "Rampa.h"
+#include "Calibracion.h"
+
+struct SinCompensacion {
+    static int16_t aplicar(int16_t velocidad) { return velocidad; }
+};
+
+// Tablas por motor (0 = derecho, 1 = izquierdo) y sentido, leídas en cada tick.
+// Detenido es siempre duty 0, sin consultar la tabla (una entrada 0 mal cargada no mueve el motor).
+template <const TablasCalibracion* TABLAS, uint8_t MOTOR>
+struct CompensacionTabla {
+    static int16_t aplicar(int16_t velocidad) {
+        if (velocidad == 0) return 0;
+        return aplicarCalibracion(*TABLAS, MOTOR, velocidad);
+    }
+};
+
+template <bool INVERTIDO = false, typename COMPENSACION = SinCompensacion>
+struct RasgosMotor {
+    static const bool invertido = INVERTIDO;
+    typedef COMPENSACION Compensacion;
+};
+
+template <uint8_t IN1, uint8_t IN2, typename RASGOS = RasgosMotor<> >
+class Motor {
+public:
+    static const uint8_t pinAdelante = RASGOS::invertido ? IN2 : IN1;
+    static const uint8_t pinAtras = RASGOS::invertido ? IN1 : IN2;
+
+    void iniciar(uint32_t frecuencia, uint8_t resolucion) {
+        hal::pwmAdjuntar(pinAdelante, frecuencia, resolucion);
+        hal::pwmAdjuntar(pinAtras, frecuencia, resolucion);
+        detener();
+    }
+
+    // Velocidad pedida (-255..255); la rampa la alcanza en los próximos ticks
+    void fijar(int16_t velocidad) {
+        if (velocidad > 255) velocidad = 255;
+        if (velocidad < -255) velocidad = -255;
+        velocidadPedida = velocidad;
+    }
+
+    // Un tick de rampa sobre la velocidad y su duty compensado. Devuelve true si
+    // el duty cambió (falta escribir()); también cambia si cambió la calibración.
+    bool paso(const ConfigRampa& c) {
+        rampa = pasoRampa(rampa, velocidadPedida, c);
+        int16_t d = RASGOS::Compensacion::aplicar(dutyRampa(rampa));
+        if (d == dutyActual) return false;
+        dutyActual = d;
+        return true;
+    }
+
+    void escribir() const {
+        if (dutyActual > 0) { hal::pwmEscribir(pinAdelante, dutyActual); hal::pwmEscribir(pinAtras, 0); }
+        else if (dutyActual < 0) { hal::pwmEscribir(pinAdelante, 0); hal::pwmEscribir(pinAtras, -dutyActual); }
+        else { hal::pwmEscribir(pinAdelante, 0); hal::pwmEscribir(pinAtras, 0); }
+    }
+
+    // Salta la rampa: velocidad y duty a 'velocidad' y escribe ya
+    void forzar(int16_t velocidad) {
+        fijar(velocidad);
+        rampa.duty = (int32_t)velocidadPedida * 256;
+        rampa.vel = 0;
+        dutyActual = RASGOS::Compensacion::aplicar(velocidadPedida);
+        escribir();
+    }
+
+    void detener() { forzar(0); }
+
+    int16_t pedido() const { return velocidadPedida; } // Antes de la compensación
+    int16_t objetivo() const { return RASGOS::Compensacion::aplicar(velocidadPedida); } // Duty al terminar la rampa
+    int16_t velocidad() const { return dutyRampa(rampa); } // Velocidad actual de la rampa
+    int16_t duty() const { return dutyActual; }
+    bool enRampa() const { return rampa.duty != (int32_t)velocidadPedida * 256 || rampa.vel != 0; }
+
+private:
+    int16_t velocidadPedida = 0;
+    int16_t dutyActual = 0;
+    EstadoRampa rampa = { 0, 0 };
+};
+
+template <typename MOTOR1, typename MOTOR2>
+class DiffDrive {
+public:
+    MOTOR1 motor1; // Derecho
+    MOTOR2 motor2; // Izquierdo
+
+    void iniciar(uint32_t frecuencia, uint8_t resolucion) {
+        motor1.iniciar(frecuencia, resolucion);
+        motor2.iniciar(frecuencia, resolucion);
+    }
+
+    void fijar(int16_t velocidad1, int16_t velocidad2) {
+        motor1.fijar(velocidad1);
+        motor2.fijar(velocidad2);
+    }
+
+    // Avanza ambas rampas y escribe solo los motores que cambiaron. Devuelve true si escribió.
+    bool actualizar(const ConfigRampa& c) {
+        bool cambio1 = motor1.paso(c);
+        bool cambio2 = motor2.paso(c);
+        if (cambio1) motor1.escribir();
+        if (cambio2) motor2.escribir();
+        return cambio1 || cambio2;
+    }
+
+    void forzar(int16_t velocidad1, int16_t velocidad2) {
+        motor1.forzar(velocidad1);
+        motor2.forzar(velocidad2);
+    }
+
+    void detener() { forzar(0, 0); }
+
+    bool enRampa() const { return motor1.enRampa() || motor2.enRampa(); }
+};
+
+#endif
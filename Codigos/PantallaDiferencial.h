@@ -0,0 +1,87 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Pantalla SSD1306 con envío diferencial
+
+  Descripción:
+  Adafruit_SSD1306 que, en display(), solo envía por I2C las páginas y
+  columnas que cambiaron desde el último envío (ver FramebufferSombra.h).
+  Redibujar la misma flecha no envía nada y cambiar los dígitos de la
+  velocidad envía solo sus columnas, en lugar de los 1024 bytes completos.
+  Se usa igual que Adafruit_SSD1306.
+  ============================================================================
+*/
+
+#ifndef PANTALLA_DIFERENCIAL_H
+#define PANTALLA_DIFERENCIAL_H
+
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "FramebufferSombra.h"
+
+template <uint8_t ANCHO, uint8_t ALTO>
+class PantallaDiferencial : public Adafruit_SSD1306 {
+public:
+    PantallaDiferencial(TwoWire* twi, int8_t rst_pin = -1)
+        : Adafruit_SSD1306(ANCHO, ALTO, twi, rst_pin), bus(twi) {}
+
+    bool begin(uint8_t vcs, uint8_t addr) {
+        direccion = addr;
+        sombra.invalidar();
+        return Adafruit_SSD1306::begin(vcs, addr);
+    }
+
+    // Oculta Adafruit_SSD1306::display(): envía solo lo que cambió
+    void display() {
+        RangoPagina rangos[FramebufferSombra<ANCHO, ALTO>::PAGINAS];
+        uint8_t n = sombra.calcular(getBuffer(), rangos);
+        bytesUltimoEnvio = 0;
+        if (n == 0) return;
+
+        bus->setClock(400000);
+        const uint8_t* buffer = getBuffer();
+        for (uint8_t i = 0; i < n; i++) {
+            const RangoPagina& r = rangos[i];
+            const uint8_t ventana[] = { SSD1306_COLUMNADDR, r.colInicio, r.colFin,
+                                        SSD1306_PAGEADDR, r.pagina, r.pagina };
+            comandos(ventana, sizeof(ventana));
+            enviarDatos(buffer + (size_t)r.pagina * ANCHO + r.colInicio, r.colFin - r.colInicio + 1);
+        }
+    }
+
+    // Fuerza un envío completo en el próximo display() (p. ej. tras un reset del SSD1306)
+    void invalidar() { sombra.invalidar(); }
+
+    // Bytes de datos del framebuffer enviados en el último display()
+    uint16_t bytesUltimoEnvio = 0;
+
+private:
+    static const uint8_t DATOS_POR_TRANSMISION = 31; // 32 con el byte de control, válido en cualquier Wire
+
+    void comandos(const uint8_t* lista, uint8_t cantidad) {
+        bus->beginTransmission(direccion);
+        bus->write((uint8_t)0x00); // Co = 0, D/C = 0: el resto son comandos
+        bus->write(lista, cantidad);
+        bus->endTransmission();
+    }
+
+    void enviarDatos(const uint8_t* datos, uint16_t cantidad) {
+        bytesUltimoEnvio += cantidad;
+        while (cantidad > 0) {
+            uint8_t trozo = cantidad > DATOS_POR_TRANSMISION ? DATOS_POR_TRANSMISION : (uint8_t)cantidad;
+            bus->beginTransmission(direccion);
+            bus->write((uint8_t)0x40); // Co = 0, D/C = 1
+            bus->write(datos, trozo);
+            bus->endTransmission();
+            datos += trozo;
+            cantidad -= trozo;
+        }
+    }
+
+    TwoWire* bus;
+    uint8_t direccion = 0x3C;
+    FramebufferSombra<ANCHO, ALTO> sombra;
+};
+
+#endif
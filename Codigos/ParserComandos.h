@@ -0,0 +1,315 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Parser de comandos
+
+  Descripción:
+  Parser incremental (byte a byte) de los comandos ASCII del FUTBOT. Usa un
+  buffer fijo y una máquina de estados, sin String ni memoria dinámica, de
+  modo que loop() nunca se bloquea esperando el fin de línea.
+  No depende de Arduino: compila también en el PC.
+
+  Comandos reconocidos (terminados en '\n'):
+  - 'C1XXX', 'C2XXX', 'CGXXX': velocidades, XXX = 000-255
+  - 'F1', 'B1', 'S1', 'F2', 'B2', 'S2': control individual de motores
+  - 'U', 'D', 'L', 'R', 'S': movimientos generales
+  - 'X': prueba de pantalla
+  - 'M': informe de latencias, 'MB': borrar latencias
+  - 'G0'..'G9': grabar macro en esa ranura, 'GS': terminar y guardar,
+    'P0'..'P9': reproducir macro (Macro.h; la ranura la valida quien ejecuta)
+  Byte suelto BYTE_VIDA (0x16, SYN) al inicio de línea: mantiene vivo el
+  vigilante sin reenviar el último movimiento; no necesita '\n'.
+  Además detecta las tramas binarias de ProtocoloBinario.h por su byte de
+  sincronía y las entrega como comandos del mismo flujo.
+  ============================================================================
+*/
+
+#ifndef PARSER_COMANDOS_H
+#define PARSER_COMANDOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ProtocoloBinario.h"
+
+const uint8_t BYTE_VIDA = 0x16;
+
+enum TipoComando : uint8_t {
+    CMD_VELOCIDAD,       // C1XXX / C2XXX / CGXXX
+    CMD_MOTOR,           // F1, B1, S1, F2, B2, S2
+    CMD_GENERAL,         // U, D, L, R, S
+    CMD_PRUEBA_PANTALLA, // X
+    CMD_METRICAS,        // M (informe) / MB (borrar)
+    CMD_MACRO,           // G<n> / GS (grabar) y P<n> (reproducir)
+    CMD_MANEJO,          // Trama binaria TRAMA_MANEJO
+    CMD_ANALOGICO,       // Trama binaria TRAMA_ANALOGICO
+    CMD_VIDA,            // BYTE_VIDA
+    CMD_TRAMA,           // Otra trama binaria válida (ver 'trama')
+    CMD_ERROR            // Ver ErrorComando
+};
+
+enum ErrorComando : uint8_t {
+    ERR_NINGUNO,
+    ERR_FUERA_DE_RANGO,  // Velocidad > 255 o no numérica, o duty fuera de -255..255
+    ERR_C_INCOMPLETO,    // Comando C sin sus 3 dígitos
+    ERR_FBS_MALFORMADO,  // F/B/S con motor inválido o caracteres extra
+    ERR_DESCONOCIDO,     // Primer carácter no reconocido
+    ERR_TRAMA_CRC,       // Trama binaria corrupta
+    ERR_TRAMA_VIEJA,     // Trama binaria con secuencia antigua
+    ERR_TRAMA_TIPO       // Trama binaria con largo inválido para su tipo
+};
+
+struct Comando {
+    TipoComando tipo;
+    char letra;          // Primer carácter del comando ('C', 'F', 'U', ...)
+    char objetivo;       // '1', '2', 'G', 'B' (MB), ranura de macro o '\0' si no aplica
+    uint8_t valor;       // Velocidad para CMD_VELOCIDAD
+    int16_t duty1;       // CMD_MANEJO: motor 1 (derecho), -255..255
+    int16_t duty2;       // CMD_MANEJO: motor 2 (izquierdo), -255..255
+    int8_t acelerador;   // CMD_ANALOGICO: -127..127 (-128 se trata como -127)
+    int8_t giro;         // CMD_ANALOGICO: -127..127
+    const Trama* trama;  // CMD_TRAMA: válida hasta el siguiente byte
+    ErrorComando error;
+};
+
+class ParserComandos {
+public:
+    static const size_t LARGO_MAX_LINEA = 16; // Solo para eco/depuración
+
+    ParserComandos() : actual() { reiniciar(); }
+
+    // Procesa un byte. Devuelve true cuando hay un comando completo en 'cmd'.
+    bool alimentar(uint8_t c, Comando& cmd) {
+        if (binario.enCurso()) return alimentarBinario(c, cmd);
+        if (estado == ESPERA_INICIO && c == TRAMA_SYNC) {
+            largo = 0;
+            linea[0] = '\0';
+            return alimentarBinario(c, cmd);
+        }
+        if (estado == ESPERA_INICIO && c == BYTE_VIDA) {
+            cmd.tipo = CMD_VIDA;
+            cmd.letra = cmd.objetivo = '\0';
+            cmd.trama = NULL;
+            cmd.error = ERR_NINGUNO;
+            return true;
+        }
+        if (c == '\n') return finalizar(cmd);
+        if (c == '\r') return false;
+
+        if (estado == ESPERA_INICIO) {
+            if (c == ' ' || c == '\t') return false;
+            largo = 0;
+        }
+        if (largo < LARGO_MAX_LINEA) linea[largo++] = (char)c;
+        linea[largo] = '\0';
+
+        switch (estado) {
+            case ESPERA_INICIO:
+                actual.letra = (char)c;
+                actual.objetivo = '\0';
+                actual.valor = 0;
+                actual.duty1 = actual.duty2 = 0;
+                actual.acelerador = actual.giro = 0;
+                actual.trama = NULL;
+                digitos = espaciosDigitos = 0;
+                valorAcum = 0;
+                valorInvalido = false;
+                estado = ESPERA_OBJETIVO;
+                espaciosFinales = false;
+                break;
+
+            case ESPERA_OBJETIVO:
+                if (c == ' ' || c == '\t') {
+                    // 'S ' sigue siendo válido; 'C ' no lleva objetivo
+                    espaciosFinales = true;
+                    break;
+                }
+                if (espaciosFinales) { estado = DESCARTE; break; }
+                actual.objetivo = (char)c;
+                estado = (actual.letra == 'C') ? DIGITOS : RESTO;
+                break;
+
+            case DIGITOS:
+                // Los 3 caracteres del valor deben ser dígitos ('C1-12' está fuera de rango, como con
+                // toInt()). Los espacios solo cuentan si les sigue algo: los finales se recortan (trim())
+                if (c == ' ' || c == '\t') {
+                    if (digitos + espaciosDigitos < 3) espaciosDigitos++;
+                    break;
+                }
+                if (espaciosDigitos > 0) {
+                    digitos += espaciosDigitos;
+                    espaciosDigitos = 0;
+                    valorInvalido = true;
+                }
+                if (digitos < 3) {
+                    if (c >= '0' && c <= '9') valorAcum = valorAcum * 10 + (c - '0');
+                    else valorInvalido = true;
+                    digitos++;
+                }
+                break;
+
+            case RESTO:
+                if (c != ' ' && c != '\t') extra = true;
+                break;
+
+            case DESCARTE:
+                break;
+        }
+        return false;
+    }
+
+    // Cierra la línea en curso como si hubiera llegado '\n'. Útil cuando el
+    // cliente no envía fin de línea y se detecta inactividad en el enlace.
+    bool finalizar(Comando& cmd) {
+        if (binario.enCurso()) {
+            binario.descartar(); // Trama incompleta: se pierde
+            return false;
+        }
+        if (estado == ESPERA_INICIO) return false;
+        bool listo = interpretar(cmd);
+        estado = ESPERA_INICIO;
+        digitos = espaciosDigitos = 0;
+        extra = false;
+        return listo;
+    }
+
+    // True si hay una línea a medio recibir
+    bool pendiente() const { return estado != ESPERA_INICIO || binario.enCurso(); }
+
+    // Texto de la última línea (recortado a LARGO_MAX_LINEA), válido hasta el siguiente byte
+    const char* ultimaLinea() const { return linea; }
+
+    void reiniciar() {
+        binario.reiniciar();
+        estado = ESPERA_INICIO;
+        largo = 0;
+        linea[0] = '\0';
+        digitos = espaciosDigitos = 0;
+        valorAcum = 0;
+        valorInvalido = false;
+        extra = false;
+        espaciosFinales = false;
+    }
+
+private:
+    enum Estado : uint8_t { ESPERA_INICIO, ESPERA_OBJETIVO, DIGITOS, RESTO, DESCARTE };
+
+    bool alimentarBinario(uint8_t c, Comando& cmd) {
+        ResultadoTrama r = binario.alimentar(c, trama);
+        if (r == TRAMA_INCOMPLETA) return false;
+
+        cmd.letra = '\0';
+        cmd.objetivo = '\0';
+        cmd.valor = 0;
+        cmd.trama = NULL;
+        if (r == TRAMA_ERROR_CRC) return error(cmd, ERR_TRAMA_CRC);
+        if (r == TRAMA_VIEJA) return error(cmd, ERR_TRAMA_VIEJA);
+
+        if (trama.tipo == TRAMA_MANEJO && trama.largo == TRAMA_MANEJO_LARGO) {
+            cmd.duty1 = leerInt16(trama.datos);
+            cmd.duty2 = leerInt16(trama.datos + 2);
+            if (cmd.duty1 < -255 || cmd.duty1 > 255 || cmd.duty2 < -255 || cmd.duty2 > 255) {
+                return error(cmd, ERR_FUERA_DE_RANGO);
+            }
+            cmd.tipo = CMD_MANEJO;
+            cmd.error = ERR_NINGUNO;
+            return true;
+        }
+        if (trama.tipo == TRAMA_MANEJO) return error(cmd, ERR_TRAMA_TIPO);
+        if (trama.tipo == TRAMA_ANALOGICO) {
+            if (trama.largo != TRAMA_ANALOGICO_LARGO) return error(cmd, ERR_TRAMA_TIPO);
+            cmd.acelerador = (int8_t)trama.datos[0];
+            cmd.giro = (int8_t)trama.datos[1];
+            cmd.tipo = CMD_ANALOGICO;
+            cmd.error = ERR_NINGUNO;
+            return true;
+        }
+        cmd.tipo = CMD_TRAMA;
+        cmd.trama = &trama;
+        cmd.error = ERR_NINGUNO;
+        return true;
+    }
+
+    bool interpretar(Comando& cmd) {
+        cmd = actual;
+        cmd.error = ERR_NINGUNO;
+
+        switch (actual.letra) {
+            case 'C':
+                // Igual que antes: una "C" sola se ignora
+                if (actual.objetivo == '\0') return false;
+                if (actual.objetivo != '1' && actual.objetivo != '2' && actual.objetivo != 'G') {
+                    return error(cmd, ERR_DESCONOCIDO);
+                }
+                if (digitos < 3) return error(cmd, ERR_C_INCOMPLETO);
+                if (valorInvalido || valorAcum > 255) return error(cmd, ERR_FUERA_DE_RANGO);
+                cmd.tipo = CMD_VELOCIDAD;
+                cmd.valor = (uint8_t)valorAcum;
+                return true;
+
+            case 'F':
+            case 'B':
+            case 'S':
+                if (estado == DESCARTE || extra) return error(cmd, ERR_FBS_MALFORMADO);
+                if (actual.objetivo == '1' || actual.objetivo == '2') {
+                    cmd.tipo = CMD_MOTOR;
+                    return true;
+                }
+                if (actual.letra == 'S' && actual.objetivo == '\0') {
+                    cmd.tipo = CMD_GENERAL;
+                    return true;
+                }
+                return error(cmd, ERR_FBS_MALFORMADO);
+
+            case 'U':
+            case 'D':
+            case 'L':
+            case 'R':
+                cmd.tipo = CMD_GENERAL;
+                cmd.objetivo = '\0';
+                return true;
+
+            case 'X':
+                cmd.tipo = CMD_PRUEBA_PANTALLA;
+                cmd.objetivo = '\0';
+                return true;
+
+            case 'M':
+                if (estado == DESCARTE || extra) return error(cmd, ERR_DESCONOCIDO);
+                if (actual.objetivo != '\0' && actual.objetivo != 'B') return error(cmd, ERR_DESCONOCIDO);
+                cmd.tipo = CMD_METRICAS;
+                return true;
+            case 'G':
+            case 'P':
+                if (estado == DESCARTE || extra) return error(cmd, ERR_DESCONOCIDO);
+                if (!(actual.objetivo >= '0' && actual.objetivo <= '9') &&
+                    !(actual.letra == 'G' && actual.objetivo == 'S')) return error(cmd, ERR_DESCONOCIDO);
+                cmd.tipo = CMD_MACRO;
+                return true;
+
+            default:
+                return error(cmd, ERR_DESCONOCIDO);
+        }
+    }
+
+    static bool error(Comando& cmd, ErrorComando e) {
+        cmd.tipo = CMD_ERROR;
+        cmd.error = e;
+        return true;
+    }
+
+    Estado estado;
+    Comando actual;
+    DecodificadorTramas binario;
+    Trama trama;
+    char linea[LARGO_MAX_LINEA + 1];
+    uint8_t largo;
+    uint8_t digitos;         // Caracteres consumidos tras 'C' + objetivo (máx. 3)
+    uint8_t espaciosDigitos; // Espacios aún sin contar: si la línea termina, se recortan
+    uint16_t valorAcum;
+    bool valorInvalido;      // Algún carácter del valor no es dígito
+    bool extra;           // Caracteres sobrantes tras F/B/S + motor
+    bool espaciosFinales;
+};
+
+#endif
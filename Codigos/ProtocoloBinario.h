@@ -0,0 +1,287 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Protocolo binario de control
+
+  Descripción:
+  Tramas binarias compactas que conviven con los comandos ASCII. Se detectan
+  por el byte de sincronía 0xA5, que nunca inicia un comando de texto.
+  Lo usa el firmware para decodificar y el PC/app para codificar: no depende
+  de Arduino.
+
+  Formato de trama:
+    [0xA5] [TIPO] [LARGO] [SEQ] [DATOS x LARGO] [CRC8]
+  - CRC8 (polinomio 0x07, valor inicial 0x00) sobre TIPO..DATOS.
+  - SEQ aumenta en cada trama; las tramas con SEQ igual o anterior a la
+    última aceptada se descartan (comparación módulo 256).
+
+  Tipos:
+  - TRAMA_MANEJO (0x01): int16 duty motor 1 (derecho), int16 duty motor 2
+    (izquierdo), little endian, -255..255. Positivo = adelante.
+  - TRAMA_CALIBRACION (0x02): uint8 tabla (motor * 2 + sentido), uint8
+    posición inicial, y hasta 30 valores. Escribe en una copia pendiente de
+    las tablas de Calibracion.h.
+  - TRAMA_CALIBRACION_FIN (0x03): uint8 acción (CAL_APLICAR, CAL_GUARDAR o
+    CAL_RESTAURAR).
+  - TRAMA_ANALOGICO (0x04): int8 acelerador, int8 giro, -127..127. Positivo =
+    adelante / giro como 'R'. El robot los mezcla por rueda (Mezclador.h).
+  - TRAMA_VIGILANTE (0x05): uint16 timeout del vigilante en ms, little
+    endian (VIGILANTE_MS_MIN..VIGILANTE_MS_MAX).
+  - TRAMA_TELEMETRIA_CONFIG (0x06): uint16 periodo de muestreo en ms (0 =
+    apagada, si no TELEMETRIA_MS_MIN..), uint8 muestras por lote
+    (1..TELEMETRIA_LOTE_MAX).
+  - TRAMA_TELEMETRIA (0x07, robot -> PC/app): una MuestraTelemetria. Se
+    envían en lotes de varias tramas seguidas en una sola escritura.
+  - TRAMA_MEZCLA (0x08): uint8 expo del acelerador, uint8 expo del giro (Q8,
+    0 = lineal .. 255 casi cúbica, ver Mezclador.h). Se guarda en NVS.
+  ============================================================================
+*/
+
+#ifndef PROTOCOLO_BINARIO_H
+#define PROTOCOLO_BINARIO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+const uint8_t TRAMA_SYNC = 0xA5;
+const uint8_t TRAMA_DATOS_MAX = 32;
+const uint8_t TRAMA_CABECERA = 4;                                // SYNC, TIPO, LARGO, SEQ
+const uint8_t TRAMA_LARGO_MAX = TRAMA_CABECERA + TRAMA_DATOS_MAX + 1;
+
+enum TipoTrama : uint8_t {
+    TRAMA_MANEJO = 0x01,
+    TRAMA_CALIBRACION = 0x02,
+    TRAMA_CALIBRACION_FIN = 0x03,
+    TRAMA_ANALOGICO = 0x04,
+    TRAMA_VIGILANTE = 0x05,
+    TRAMA_TELEMETRIA_CONFIG = 0x06,
+    TRAMA_TELEMETRIA = 0x07,
+    TRAMA_MEZCLA = 0x08
+};
+
+const uint8_t TRAMA_MANEJO_LARGO = 4;
+const uint8_t TRAMA_CALIBRACION_VALORES_MAX = TRAMA_DATOS_MAX - 2;
+const uint8_t TRAMA_ANALOGICO_LARGO = 2;
+const uint8_t TRAMA_VIGILANTE_LARGO = 2;
+const uint16_t VIGILANTE_MS_MIN = 20;
+const uint16_t VIGILANTE_MS_MAX = 5000;
+const uint8_t TRAMA_TELEMETRIA_CONFIG_LARGO = 3;
+const uint8_t TRAMA_TELEMETRIA_LARGO = 21;
+const uint8_t TRAMA_TELEMETRIA_BYTES = TRAMA_CABECERA + TRAMA_TELEMETRIA_LARGO + 1;
+const uint16_t TELEMETRIA_MS_MIN = 10;
+const uint8_t TELEMETRIA_LOTE_MAX = 8;
+const uint8_t TRAMA_MEZCLA_LARGO = 2;
+
+// Contenido de TRAMA_TELEMETRIA, en este orden, little endian
+struct MuestraTelemetria {
+    uint32_t ms;               // millis() del robot
+    uint8_t duty[4];           // Canales M1 IN1, M1 IN2, M2 IN1, M2 IN2
+    uint8_t velocidad[3];      // motor1Speed, motor2Speed, generalSpeed
+    uint16_t periodoMaxUs;     // Peor periodo del tick de control desde la muestra anterior
+    uint16_t colaRx;           // Bytes esperando en el enlace
+    uint16_t descartados;      // Comandos con error (acumulado, módulo 65536)
+    uint16_t agrupados;        // Movimientos agrupados (acumulado, módulo 65536)
+    uint16_t msDesdeComando;   // Saturado a 65535
+};
+
+enum AccionCalibracion : uint8_t {
+    CAL_APLICAR = 0,   // Usar las tablas recibidas
+    CAL_GUARDAR = 1,   // Usarlas y guardarlas en memoria no volátil
+    CAL_RESTAURAR = 2  // Volver a las tablas por defecto y borrar las guardadas
+};
+
+struct Trama {
+    uint8_t tipo;
+    uint8_t seq;
+    uint8_t largo;
+    uint8_t datos[TRAMA_DATOS_MAX];
+};
+
+enum ResultadoTrama : uint8_t {
+    TRAMA_INCOMPLETA,
+    TRAMA_OK,
+    TRAMA_ERROR_CRC,     // CRC incorrecto o largo inválido
+    TRAMA_VIEJA          // Secuencia repetida o anterior a la última aceptada
+};
+
+inline uint8_t crc8(uint8_t crc, uint8_t dato) {
+    crc ^= dato;
+    for (uint8_t i = 0; i < 8; i++) {
+        crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+inline uint8_t crc8(const uint8_t* datos, size_t largo, uint8_t crc = 0) {
+    for (size_t i = 0; i < largo; i++) crc = crc8(crc, datos[i]);
+    return crc;
+}
+
+inline int16_t leerInt16(const uint8_t* p) {
+    return (int16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+}
+
+inline void escribirInt16(uint8_t* p, int16_t v) {
+    p[0] = (uint8_t)((uint16_t)v & 0xFF);
+    p[1] = (uint8_t)((uint16_t)v >> 8);
+}
+
+inline uint16_t leerUint16(const uint8_t* p) { return (uint16_t)leerInt16(p); }
+inline void escribirUint16(uint8_t* p, uint16_t v) { escribirInt16(p, (int16_t)v); }
+
+inline uint32_t leerUint32(const uint8_t* p) {
+    return (uint32_t)leerUint16(p) | ((uint32_t)leerUint16(p + 2) << 16);
+}
+
+inline void escribirUint32(uint8_t* p, uint32_t v) {
+    escribirUint16(p, (uint16_t)(v & 0xFFFF));
+    escribirUint16(p + 2, (uint16_t)(v >> 16));
+}
+
+// Escribe una trama completa en 'salida' (al menos TRAMA_LARGO_MAX bytes).
+// Devuelve el número de bytes escritos, o 0 si 'largo' excede el máximo.
+inline size_t codificarTrama(uint8_t tipo, uint8_t seq, const uint8_t* datos, uint8_t largo, uint8_t* salida) {
+    if (largo > TRAMA_DATOS_MAX) return 0;
+    salida[0] = TRAMA_SYNC;
+    salida[1] = tipo;
+    salida[2] = largo;
+    salida[3] = seq;
+    for (uint8_t i = 0; i < largo; i++) salida[TRAMA_CABECERA + i] = datos[i];
+    salida[TRAMA_CABECERA + largo] = crc8(salida + 1, TRAMA_CABECERA - 1 + largo);
+    return TRAMA_CABECERA + largo + 1;
+}
+
+inline size_t codificarManejo(uint8_t seq, int16_t duty1, int16_t duty2, uint8_t* salida) {
+    uint8_t datos[TRAMA_MANEJO_LARGO];
+    escribirInt16(datos, duty1);
+    escribirInt16(datos + 2, duty2);
+    return codificarTrama(TRAMA_MANEJO, seq, datos, TRAMA_MANEJO_LARGO, salida);
+}
+
+inline size_t codificarAnalogico(uint8_t seq, int8_t acelerador, int8_t giro, uint8_t* salida) {
+    uint8_t datos[TRAMA_ANALOGICO_LARGO] = { (uint8_t)acelerador, (uint8_t)giro };
+    return codificarTrama(TRAMA_ANALOGICO, seq, datos, TRAMA_ANALOGICO_LARGO, salida);
+}
+
+inline size_t codificarVigilante(uint8_t seq, uint16_t timeoutMs, uint8_t* salida) {
+    uint8_t datos[TRAMA_VIGILANTE_LARGO];
+    escribirUint16(datos, timeoutMs);
+    return codificarTrama(TRAMA_VIGILANTE, seq, datos, TRAMA_VIGILANTE_LARGO, salida);
+}
+
+inline size_t codificarTelemetriaConfig(uint8_t seq, uint16_t periodoMs, uint8_t muestrasPorLote, uint8_t* salida) {
+    uint8_t datos[TRAMA_TELEMETRIA_CONFIG_LARGO];
+    escribirUint16(datos, periodoMs);
+    datos[2] = muestrasPorLote;
+    return codificarTrama(TRAMA_TELEMETRIA_CONFIG, seq, datos, TRAMA_TELEMETRIA_CONFIG_LARGO, salida);
+}
+
+inline size_t codificarMezcla(uint8_t seq, uint8_t expoAcelerador, uint8_t expoGiro, uint8_t* salida) {
+    uint8_t datos[TRAMA_MEZCLA_LARGO] = { expoAcelerador, expoGiro };
+    return codificarTrama(TRAMA_MEZCLA, seq, datos, TRAMA_MEZCLA_LARGO, salida);
+}
+
+inline size_t codificarTelemetria(uint8_t seq, const MuestraTelemetria& m, uint8_t* salida) {
+    uint8_t datos[TRAMA_TELEMETRIA_LARGO];
+    escribirUint32(datos, m.ms);
+    for (uint8_t i = 0; i < 4; i++) datos[4 + i] = m.duty[i];
+    for (uint8_t i = 0; i < 3; i++) datos[8 + i] = m.velocidad[i];
+    escribirUint16(datos + 11, m.periodoMaxUs);
+    escribirUint16(datos + 13, m.colaRx);
+    escribirUint16(datos + 15, m.descartados);
+    escribirUint16(datos + 17, m.agrupados);
+    escribirUint16(datos + 19, m.msDesdeComando);
+    return codificarTrama(TRAMA_TELEMETRIA, seq, datos, TRAMA_TELEMETRIA_LARGO, salida);
+}
+
+// False si la trama no es una TRAMA_TELEMETRIA válida
+inline bool leerTelemetria(const Trama& t, MuestraTelemetria& m) {
+    if (t.tipo != TRAMA_TELEMETRIA || t.largo != TRAMA_TELEMETRIA_LARGO) return false;
+    m.ms = leerUint32(t.datos);
+    for (uint8_t i = 0; i < 4; i++) m.duty[i] = t.datos[4 + i];
+    for (uint8_t i = 0; i < 3; i++) m.velocidad[i] = t.datos[8 + i];
+    m.periodoMaxUs = leerUint16(t.datos + 11);
+    m.colaRx = leerUint16(t.datos + 13);
+    m.descartados = leerUint16(t.datos + 15);
+    m.agrupados = leerUint16(t.datos + 17);
+    m.msDesdeComando = leerUint16(t.datos + 19);
+    return true;
+}
+
+// Escribe 'cantidad' valores de la tabla 'tabla' a partir de 'posicion'
+inline size_t codificarCalibracion(uint8_t seq, uint8_t tabla, uint8_t posicion, const uint8_t* valores, uint8_t cantidad, uint8_t* salida) {
+    if (cantidad > TRAMA_CALIBRACION_VALORES_MAX) return 0;
+    uint8_t datos[TRAMA_DATOS_MAX];
+    datos[0] = tabla;
+    datos[1] = posicion;
+    for (uint8_t i = 0; i < cantidad; i++) datos[2 + i] = valores[i];
+    return codificarTrama(TRAMA_CALIBRACION, seq, datos, (uint8_t)(cantidad + 2), salida);
+}
+
+inline size_t codificarCalibracionFin(uint8_t seq, AccionCalibracion accion, uint8_t* salida) {
+    uint8_t dato = accion;
+    return codificarTrama(TRAMA_CALIBRACION_FIN, seq, &dato, 1, salida);
+}
+
+// Decodificador incremental. Debe recibir los bytes a partir del de sincronía.
+class DecodificadorTramas {
+public:
+    DecodificadorTramas() { reiniciar(); }
+
+    ResultadoTrama alimentar(uint8_t c, Trama& trama) {
+        switch (posicion) {
+            case 0:
+                // Sincronía: la valida quien llama, pero se tolera recibirla
+                if (c != TRAMA_SYNC) return TRAMA_INCOMPLETA;
+                crc = 0;
+                break;
+            case 1:
+                trama.tipo = c;
+                break;
+            case 2:
+                if (c > TRAMA_DATOS_MAX) { posicion = 0; return TRAMA_ERROR_CRC; }
+                trama.largo = c;
+                break;
+            case 3:
+                trama.seq = c;
+                break;
+            default:
+                if (posicion < TRAMA_CABECERA + trama.largo) {
+                    trama.datos[posicion - TRAMA_CABECERA] = c;
+                    break;
+                }
+                // Último byte: CRC
+                posicion = 0;
+                if (c != crc) return TRAMA_ERROR_CRC;
+                if (haySeq && (int8_t)(trama.seq - ultimaSeq) <= 0) return TRAMA_VIEJA;
+                ultimaSeq = trama.seq;
+                haySeq = true;
+                return TRAMA_OK;
+        }
+        if (posicion > 0) crc = crc8(crc, c);
+        posicion++;
+        return TRAMA_INCOMPLETA;
+    }
+
+    bool enCurso() const { return posicion != 0; }
+
+    // Descarta la trama a medio recibir (p. ej. por inactividad)
+    void descartar() { posicion = 0; }
+
+    // Olvida también la secuencia (nueva conexión)
+    void reiniciar() {
+        posicion = 0;
+        crc = 0;
+        ultimaSeq = 0;
+        haySeq = false;
+    }
+
+private:
+    uint8_t posicion;
+    uint8_t crc;
+    uint8_t ultimaSeq;
+    bool haySeq;
+};
+
+#endif
@@ -24,51 +24,38 @@
   ============================================================================
 */
 
+#include "Motor.h"
+
 #define MOTOR_IZQ_A 27
 #define MOTOR_IZQ_B 26
 #define MOTOR_DER_A 2
 #define MOTOR_DER_B 4
 
+// Pin A = adelante. Sin rampa ni calibración: cada paso se aplica de inmediato
+DiffDrive<Motor<MOTOR_DER_A, MOTOR_DER_B>, Motor<MOTOR_IZQ_A, MOTOR_IZQ_B> > ruedas;
+
 void setup() {
-    pinMode(MOTOR_IZQ_A, OUTPUT);
-    pinMode(MOTOR_IZQ_B, OUTPUT);
-    pinMode(MOTOR_DER_A, OUTPUT);
-    pinMode(MOTOR_DER_B, OUTPUT);
+    ruedas.iniciar(30000, 8);
 }
 
 void loop() {
     // Avanzar
-    digitalWrite(MOTOR_IZQ_A, HIGH);
-    digitalWrite(MOTOR_IZQ_B, LOW);
-    digitalWrite(MOTOR_DER_A, HIGH);
-    digitalWrite(MOTOR_DER_B, LOW);
+    ruedas.forzar(255, 255);
     delay(2000);
 
     // Retroceder
-    digitalWrite(MOTOR_IZQ_A, LOW);
-    digitalWrite(MOTOR_IZQ_B, HIGH);
-    digitalWrite(MOTOR_DER_A, LOW);
-    digitalWrite(MOTOR_DER_B, HIGH);
+    ruedas.forzar(-255, -255);
     delay(2000);
 
     // Girar izquierda
-    digitalWrite(MOTOR_IZQ_A, LOW);
-    digitalWrite(MOTOR_IZQ_B, HIGH);
-    digitalWrite(MOTOR_DER_A, HIGH);
-    digitalWrite(MOTOR_DER_B, LOW);
+    ruedas.forzar(255, -255);
     delay(2000);
 
     // Girar derecha
-    digitalWrite(MOTOR_IZQ_A, HIGH);
-    digitalWrite(MOTOR_IZQ_B, LOW);
-    digitalWrite(MOTOR_DER_A, LOW);
-    digitalWrite(MOTOR_DER_B, HIGH);
+    ruedas.forzar(-255, 255);
     delay(2000);
 
     // Detenerse
-    digitalWrite(MOTOR_IZQ_A, LOW);
-    digitalWrite(MOTOR_IZQ_B, LOW);
-    digitalWrite(MOTOR_DER_A, LOW);
-    digitalWrite(MOTOR_DER_B, LOW);
+    ruedas.detener();
     delay(2000);
 }
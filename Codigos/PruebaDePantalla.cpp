@@ -26,49 +26,47 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "Sprites.h"
 
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
 
-// Flecha hacia arriba
-void drawArrowUp(int offsetY) {
+// Flechas precalculadas al compilar (ver Sprites.h): dibujarlas es copiar bytes al framebuffer
+// Flecha hacia arriba: punta (54,22)-(74,22)-(64,4), cuerpo de 12x32 en (58,22)
+constexpr Sprite<21, 50> flechaArriba = rasterizar<21, 50>(Flecha{{54, 22, 74, 22, 64, 4}, {58, 22, 12, 32}}, 54, 4);
+// Flecha hacia la derecha: punta (108,20)-(108,44)-(124,32), cuerpo de 48x12 en (60,26)
+constexpr Sprite<65, 25> flechaDerecha = rasterizar<65, 25>(Flecha{{108, 20, 108, 44, 124, 32}, {60, 26, 48, 12}}, 60, 20);
+// Flecha hacia abajo: punta (54,42)-(74,42)-(64,60), cuerpo de 12x32 en (58,10)
+constexpr Sprite<21, 51> flechaAbajo = rasterizar<21, 51>(Flecha{{54, 42, 74, 42, 64, 60}, {58, 10, 12, 32}}, 54, 10);
+// Flecha hacia la izquierda: punta (20,20)-(20,44)-(4,32), cuerpo de 48x12 en (20,26)
+constexpr Sprite<64, 25> flechaIzquierda = rasterizar<64, 25>(Flecha{{20, 20, 20, 44, 4, 32}, {20, 26, 48, 12}}, 4, 20);
+
+template <uint8_t W, uint8_t H>
+void mostrarFlecha(const Sprite<W, H>& flecha, int offsetX, int offsetY) {
   display.clearDisplay();
-  // Punta de la flecha (más ancha)
-  display.fillTriangle(54, 22 + offsetY, 74, 22 + offsetY, 64, 4 + offsetY, SSD1306_WHITE);
-  // Cuerpo de la flecha (más grueso)
-  display.fillRect(58, 22 + offsetY, 12, 32, SSD1306_WHITE);
+  dibujarSprite(display.getBuffer(), SCREEN_WIDTH, SCREEN_HEIGHT, flecha, offsetX, offsetY);
   display.display();
 }
 
+// Flecha hacia arriba
+void drawArrowUp(int offsetY) {
+  mostrarFlecha(flechaArriba, 0, offsetY);
+}
+
 // Flecha hacia la derecha
 void drawArrowRight(int offsetX) {
-  display.clearDisplay();
-  // Punta de la flecha (más ancha)
-  display.fillTriangle(108 + offsetX, 20, 108 + offsetX, 44, 124 + offsetX, 32, SSD1306_WHITE);
-  // Cuerpo de la flecha (más grueso)
-  display.fillRect(60 + offsetX, 26, 48, 12, SSD1306_WHITE);
-  display.display();
+  mostrarFlecha(flechaDerecha, offsetX, 0);
 }
 
 // Flecha hacia abajo
 void drawArrowDown(int offsetY) {
-  display.clearDisplay();
-  // Punta de la flecha (más ancha)
-  display.fillTriangle(54, 42 + offsetY, 74, 42 + offsetY, 64, 60 + offsetY, SSD1306_WHITE);
-  // Cuerpo de la flecha (más grueso)
-  display.fillRect(58, 10 + offsetY, 12, 32, SSD1306_WHITE);
-  display.display();
+  mostrarFlecha(flechaAbajo, 0, offsetY);
 }
 
 // Flecha hacia la izquierda
 void drawArrowLeft(int offsetX) {
-  display.clearDisplay();
-  // Punta de la flecha (más ancha)
-  display.fillTriangle(20 + offsetX, 20, 20 + offsetX, 44, 4 + offsetX, 32, SSD1306_WHITE);
-  // Cuerpo de la flecha (más grueso)
-  display.fillRect(20 + offsetX, 26, 48, 12, SSD1306_WHITE);
-  display.display();
+  mostrarFlecha(flechaIzquierda, offsetX, 0);
 }
 
 void setup() {
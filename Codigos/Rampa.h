@@ -0,0 +1,99 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Rampas de velocidad para los motores
+
+  Descripción:
+  Generador de rampa en punto fijo (Q8: duty * 256) que lleva cada motor
+  desde su duty actual hasta el objetivo con la pendiente limitada, para
+  evitar picos de corriente y deslizamiento al invertir el giro.
+  - Solo pendiente (acelMax = 0): el duty cambia como máximo velMax por tick.
+  - Trapezoidal (acelMax > 0): la pendiente cambia como máximo acelMax por
+    tick, hasta velMax, y se reduce a tiempo para llegar al objetivo sin
+    pasarse (salvo que el objetivo cambie y ya no sea posible frenar).
+  En ambos casos el duty final es exactamente el objetivo.
+  Función pura sin dependencias de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef RAMPA_H
+#define RAMPA_H
+
+#include <stdint.h>
+
+struct ConfigRampa {
+    int32_t velMax;  // Cambio máximo de duty por tick, Q8 (> 0)
+    int32_t acelMax; // Cambio máximo de velMax por tick, Q8; 0 = solo pendiente
+};
+
+struct EstadoRampa {
+    int32_t duty; // Q8, -255*256..255*256
+    int32_t vel;  // Q8 por tick, con signo
+};
+
+// Configuración para recorrer 0..255 en 'msPlenaEscala' con un tick de 'hzTick'.
+// 'msAceleracion' es el tiempo para alcanzar esa pendiente (0 = inmediato).
+inline ConfigRampa configurarRampa(uint32_t msPlenaEscala, uint32_t msAceleracion, uint32_t hzTick) {
+    ConfigRampa c;
+    uint32_t ticksPlena = msPlenaEscala * hzTick / 1000;
+    c.velMax = ticksPlena > 0 ? (int32_t)((255UL * 256UL + ticksPlena - 1) / ticksPlena) : 255 * 256;
+    uint32_t ticksAcel = msAceleracion * hzTick / 1000;
+    c.acelMax = ticksAcel > 0 ? (c.velMax + (int32_t)ticksAcel - 1) / (int32_t)ticksAcel : 0;
+    return c;
+}
+
+inline int16_t dutyRampa(const EstadoRampa& e) {
+    // Redondeo hacia cero: el valor entero nunca supera al real
+    return (int16_t)(e.duty / 256);
+}
+
+// Distancia recorrida frenando desde 'vel' con desaceleración 'acel': (v-a) + (v-2a) + ... > 0
+inline int64_t distanciaFrenado(int32_t vel, int32_t acel) {
+    if (vel <= acel) return 0;
+    int64_t n = (vel - 1) / acel;
+    return n * vel - (int64_t)acel * n * (n + 1) / 2;
+}
+
+// Un tick de rampa hacia 'objetivo' (duty entero -255..255)
+inline EstadoRampa pasoRampa(EstadoRampa e, int16_t objetivo, const ConfigRampa& c) {
+    int32_t meta = (int32_t)objetivo * 256;
+    int32_t error = meta - e.duty;
+    if (error == 0 && e.vel == 0) return e;
+
+    if (c.acelMax <= 0) {
+        int32_t paso = error > c.velMax ? c.velMax : (error < -c.velMax ? -c.velMax : error);
+        e.duty += paso;
+        e.vel = 0;
+        return e;
+    }
+
+    // Todo se calcula en la dirección del objetivo: 'vel' negativa = alejándose
+    int32_t sentido = (error > 0) ? 1 : (error < 0 ? -1 : (e.vel > 0 ? -1 : 1));
+    int32_t distancia = error * sentido;
+    int32_t vel = e.vel * sentido;
+
+    // Mayor velocidad alcanzable este tick que todavía permite frenar sin pasarse
+    int32_t minimo = vel - c.acelMax;
+    if (minimo < -c.velMax) minimo = -c.velMax;
+    int32_t maximo = vel + c.acelMax;
+    if (maximo > c.velMax) maximo = c.velMax;
+    if (maximo > distancia) maximo = distancia;
+
+    int32_t nueva = minimo; // Si ni frenando al máximo alcanza, se pasa y vuelve
+    if (maximo >= minimo) {
+        int32_t lo = minimo, hi = maximo;
+        while (lo < hi) {
+            int32_t medio = lo + (hi - lo + 1) / 2;
+            if (distancia - medio >= distanciaFrenado(medio, c.acelMax)) lo = medio;
+            else hi = medio - 1;
+        }
+        if (distancia - lo >= distanciaFrenado(lo, c.acelMax)) nueva = lo;
+    }
+
+    e.duty += nueva * sentido;
+    e.vel = nueva * sentido; // Al llegar, el tick siguiente la lleva a cero
+    return e;
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Registro diferido (log) en RAM
+
+  Descripción:
+  Los mensajes no se formatean ni se envían por Serial donde ocurren: se
+  guarda un registro binario (id de mensaje, hasta dos enteros y un texto
+  corto) en un anillo sin bloqueo, y una tarea de baja prioridad los
+  formatea y los envía cuando hay tiempo. Si el anillo se llena, el registro
+  se descarta y se cuenta en perdidos().
+  - Varios productores (cualquier tarea o núcleo), un solo consumidor.
+  - Niveles al compilar: NIVEL_REGISTRO (por defecto NIVEL_REG_INFO). Las
+    macros REG_ERROR/REG_AVISO/REG_INFO/REG_DEPURACION de niveles mayores no
+    generan código. Usan el objeto global 'registro' del programa.
+  - Formatos: texto con %d (entero con signo), %u (sin signo) y %s (el
+    texto del registro). Los enteros se toman en orden.
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <atomic>
+
+#define NIVEL_REG_NADA 0
+#define NIVEL_REG_ERROR 1
+#define NIVEL_REG_AVISO 2
+#define NIVEL_REG_INFO 3
+#define NIVEL_REG_DEPURACION 4
+
+#ifndef NIVEL_REGISTRO
+#define NIVEL_REGISTRO NIVEL_REG_INFO
+#endif
+
+const uint8_t REGISTRO_TEXTO_MAX = 16;
+
+struct RegistroBinario {
+    uint32_t ms;
+    uint8_t mensaje;                     // Índice en la tabla de formatos
+    int32_t args[2];
+    char texto[REGISTRO_TEXTO_MAX + 1];
+};
+
+// Anillo acotado de varios productores y un consumidor (cada celda lleva su
+// número de secuencia). N debe ser potencia de 2.
+template <size_t N>
+class AnilloRegistro {
+    static_assert((N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    AnilloRegistro() : cola(0), cabeza(0) {
+        for (size_t i = 0; i < N; i++) celdas[i].secuencia.store((uint32_t)i, std::memory_order_relaxed);
+    }
+
+    bool encolar(const RegistroBinario& r) {
+        uint32_t pos = cola.load(std::memory_order_relaxed);
+        Celda* celda;
+        for (;;) {
+            celda = &celdas[pos & (N - 1)];
+            int32_t dif = (int32_t)(celda->secuencia.load(std::memory_order_acquire) - pos);
+            if (dif == 0) {
+                if (cola.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false; // Lleno
+            } else {
+                pos = cola.load(std::memory_order_relaxed);
+            }
+        }
+        celda->dato = r;
+        celda->secuencia.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Solo el consumidor
+    bool desencolar(RegistroBinario& r) {
+        Celda& celda = celdas[cabeza & (N - 1)];
+        if ((int32_t)(celda.secuencia.load(std::memory_order_acquire) - (cabeza + 1)) < 0) return false;
+        r = celda.dato;
+        celda.secuencia.store(cabeza + N, std::memory_order_release);
+        cabeza++;
+        return true;
+    }
+
+private:
+    struct Celda {
+        std::atomic<uint32_t> secuencia;
+        RegistroBinario dato;
+    };
+
+    Celda celdas[N];
+    std::atomic<uint32_t> cola;
+    uint32_t cabeza;
+};
+
+// Formatea 'r' con la tabla 'formatos' en 'salida' ("[ms] mensaje"). Devuelve el largo escrito.
+inline size_t formatearRegistro(const RegistroBinario& r, const char* const* formatos, uint8_t cantidadFormatos,
+                                char* salida, size_t tamano) {
+    if (tamano == 0) return 0;
+    int n = snprintf(salida, tamano, "[%lu] ", (unsigned long)r.ms);
+    size_t largo = n < 0 ? 0 : ((size_t)n < tamano ? (size_t)n : tamano - 1);
+    const char* f = r.mensaje < cantidadFormatos ? formatos[r.mensaje] : NULL;
+    if (f == NULL) {
+        n = snprintf(salida + largo, tamano - largo, "? mensaje %u", r.mensaje);
+        return largo + (n < 0 ? 0 : ((size_t)n < tamano - largo ? (size_t)n : tamano - largo - 1));
+    }
+    uint8_t arg = 0;
+    for (; *f && largo + 1 < tamano; f++) {
+        if (f[0] == '%' && (f[1] == 'd' || f[1] == 'u' || f[1] == 's')) {
+            char valor[12];
+            const char* p = valor;
+            if (f[1] == 's') p = r.texto;
+            else if (f[1] == 'd') snprintf(valor, sizeof(valor), "%ld", (long)(arg < 2 ? r.args[arg++] : 0));
+            else snprintf(valor, sizeof(valor), "%lu", (unsigned long)(uint32_t)(arg < 2 ? r.args[arg++] : 0));
+            while (*p && largo + 1 < tamano) salida[largo++] = *p++;
+            f++;
+        } else if (f[0] == '%' && f[1] == '%') {
+            salida[largo++] = '%';
+            f++;
+        } else {
+            salida[largo++] = *f;
+        }
+    }
+    salida[largo] = '\0';
+    return largo;
+}
+
+template <size_t N>
+class Registro {
+public:
+    void registrar(uint8_t mensaje, int32_t a = 0, int32_t b = 0) { guardar(mensaje, a, b, NULL); }
+    void registrar(uint8_t mensaje, const char* texto) { guardar(mensaje, 0, 0, texto); }
+
+    // Consumidor: formatea el siguiente registro. False si no hay.
+    bool extraer(RegistroBinario& r) { return anillo.desencolar(r); }
+
+    uint32_t perdidos() const { return contadorPerdidos.load(std::memory_order_relaxed); }
+
+    // Lo fija quien conoce el reloj (hal::millis en el programa)
+    uint32_t (*reloj)() = NULL;
+
+private:
+    void guardar(uint8_t mensaje, int32_t a, int32_t b, const char* texto) {
+        RegistroBinario r;
+        r.ms = reloj ? reloj() : 0;
+        r.mensaje = mensaje;
+        r.args[0] = a;
+        r.args[1] = b;
+        uint8_t i = 0;
+        if (texto) for (; texto[i] && i < REGISTRO_TEXTO_MAX; i++) r.texto[i] = texto[i];
+        r.texto[i] = '\0';
+        if (!anillo.encolar(r)) contadorPerdidos.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    AnilloRegistro<N> anillo;
+    std::atomic<uint32_t> contadorPerdidos{0};
+};
+
+#if NIVEL_REGISTRO >= NIVEL_REG_ERROR
+#define REG_ERROR(...) registro.registrar(__VA_ARGS__)
+#else
+#define REG_ERROR(...) do {} while (0)
+#endif
+#if NIVEL_REGISTRO >= NIVEL_REG_AVISO
+#define REG_AVISO(...) registro.registrar(__VA_ARGS__)
+#else
+#define REG_AVISO(...) do {} while (0)
+#endif
+#if NIVEL_REGISTRO >= NIVEL_REG_INFO
+#define REG_INFO(...) registro.registrar(__VA_ARGS__)
+#else
+#define REG_INFO(...) do {} while (0)
+#endif
+#if NIVEL_REGISTRO >= NIVEL_REG_DEPURACION
+#define REG_DEPURACION(...) registro.registrar(__VA_ARGS__)
+#else
+#define REG_DEPURACION(...) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,201 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Sprites y tablas de giro precalculadas
+
+  Descripción:
+  Las flechas, círculos y posiciones de las animaciones son geometría fija,
+  así que se calculan en tiempo de compilación (constexpr) y quedan como
+  constantes en flash. Dibujarlas es copiar bytes al framebuffer, sin
+  fillTriangle/fillRect ni cos/sin en cada cuadro.
+
+  Formato de los sprites: el mismo del SSD1306 (un byte por columna y
+  página de 8 filas, bit 0 arriba), así el copiado es directo.
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ---------------------------------------------------------------------------
+// Formas (coordenadas de pantalla, bordes incluidos)
+// ---------------------------------------------------------------------------
+
+// Relleno por líneas como fillTriangle() de Adafruit_GFX, con sus mismas
+// divisiones enteras: el sprite queda idéntico al dibujo en tiempo de ejecución
+struct Triangulo {
+    int16_t x0, y0, x1, y1, x2, y2;
+
+    constexpr bool contiene(int16_t x, int16_t y) const {
+        // Vértices ordenados por y (a arriba, c abajo), como en fillTriangle()
+        int16_t ax = x0, ay = y0, bx = x1, by = y1, cx = x2, cy = y2;
+        if (ay > by) { intercambiar(ax, bx); intercambiar(ay, by); }
+        if (by > cy) { intercambiar(bx, cx); intercambiar(by, cy); }
+        if (ay > by) { intercambiar(ax, bx); intercambiar(ay, by); }
+        if (y < ay || y > cy) return false;
+
+        int16_t desde = 0, hasta = 0;
+        if (ay == cy) {
+            desde = minimo(ax, minimo(bx, cx));
+            hasta = maximo(ax, maximo(bx, cx));
+        } else {
+            int16_t ultima = (by == cy) ? by : by - 1; // Última fila de la mitad superior
+            if (y <= ultima) desde = ax + (int32_t)(bx - ax) * (y - ay) / (by - ay);
+            else desde = bx + (int32_t)(cx - bx) * (y - by) / (cy - by);
+            hasta = ax + (int32_t)(cx - ax) * (y - ay) / (cy - ay);
+        }
+        return x >= minimo(desde, hasta) && x <= maximo(desde, hasta);
+    }
+
+    static constexpr void intercambiar(int16_t& a, int16_t& b) {
+        int16_t t = a;
+        a = b;
+        b = t;
+    }
+    static constexpr int16_t minimo(int16_t a, int16_t b) { return a < b ? a : b; }
+    static constexpr int16_t maximo(int16_t a, int16_t b) { return a > b ? a : b; }
+};
+
+struct Rectangulo {
+    int16_t x, y, w, h; // Igual que fillRect()
+
+    constexpr bool contiene(int16_t px, int16_t py) const {
+        return px >= x && px < x + w && py >= y && py < y + h;
+    }
+};
+
+struct Circulo {
+    int16_t x, y, r; // Igual que fillCircle()
+
+    constexpr bool contiene(int16_t px, int16_t py) const {
+        // r*r + r aproxima el relleno del algoritmo de punto medio de Adafruit_GFX
+        return (int32_t)(px - x) * (px - x) + (int32_t)(py - y) * (py - y) <= (int32_t)r * r + r;
+    }
+};
+
+// Punta + cuerpo, como las flechas dibujadas con fillTriangle + fillRect
+struct Flecha {
+    Triangulo punta;
+    Rectangulo cuerpo;
+
+    constexpr bool contiene(int16_t x, int16_t y) const {
+        return punta.contiene(x, y) || cuerpo.contiene(x, y);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Sprites
+// ---------------------------------------------------------------------------
+
+template <uint8_t W, uint8_t H>
+struct Sprite {
+    static const uint8_t ANCHO = W;
+    static const uint8_t ALTO = H;
+    static const uint8_t PAGINAS = (H + 7) / 8;
+
+    int16_t x, y; // Posición en pantalla de la esquina superior izquierda
+    uint8_t datos[W * PAGINAS];
+};
+
+// Convierte una forma en sprite. (x, y) es la esquina del recuadro W x H que
+// se rasteriza; debe contener toda la forma.
+template <uint8_t W, uint8_t H, typename Forma>
+constexpr Sprite<W, H> rasterizar(const Forma& forma, int16_t x, int16_t y) {
+    Sprite<W, H> s{};
+    s.x = x;
+    s.y = y;
+    for (uint8_t fila = 0; fila < H; fila++) {
+        for (uint8_t col = 0; col < W; col++) {
+            if (forma.contiene(x + col, y + fila)) {
+                s.datos[(fila / 8) * W + col] |= (uint8_t)(1 << (fila % 8));
+            }
+        }
+    }
+    return s;
+}
+
+// OR del sprite en el framebuffer, desplazado (dx, dy). Recorta en los bordes
+// una sola vez: el bucle interno solo copia bytes.
+template <uint8_t W, uint8_t H>
+void dibujarSprite(uint8_t* fb, uint8_t anchoFb, uint8_t altoFb, const Sprite<W, H>& s, int16_t dx = 0, int16_t dy = 0) {
+    int16_t x = s.x + dx;
+    int16_t y = s.y + dy;
+    int16_t paginaBase = (y >= 0) ? (y / 8) : -((7 - y) / 8);
+    uint8_t desplazamiento = (uint8_t)(y - paginaBase * 8);
+    int16_t paginasFb = altoFb / 8;
+    int16_t colInicio = x < 0 ? -x : 0;
+    int16_t colFin = x + W > anchoFb ? anchoFb - x : W; // Exclusive
+    if (colInicio >= colFin) return;
+
+    for (uint8_t p = 0; p < Sprite<W, H>::PAGINAS; p++) {
+        int16_t pagina = paginaBase + p;
+        if (pagina + 1 < 0 || pagina >= paginasFb) continue;
+        const uint8_t* origen = s.datos + p * W;
+        uint8_t* arriba = pagina >= 0 ? fb + pagina * anchoFb + x : NULL;
+        uint8_t* abajo = (desplazamiento != 0 && pagina + 1 < paginasFb) ? fb + (pagina + 1) * anchoFb + x : NULL;
+        if (arriba != NULL && desplazamiento == 0) {
+            for (int16_t col = colInicio; col < colFin; col++) arriba[col] |= origen[col];
+            continue;
+        }
+        for (int16_t col = colInicio; col < colFin; col++) {
+            uint8_t b = origen[col];
+            if (arriba != NULL) arriba[col] |= (uint8_t)(b << desplazamiento);
+            if (abajo != NULL) abajo[col] |= (uint8_t)(b >> (8 - desplazamiento));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Posiciones de giro: centro + radio * (cos, sin) precalculado en enteros
+// ---------------------------------------------------------------------------
+
+struct Punto {
+    int16_t x, y;
+};
+
+template <uint8_t N>
+struct TablaGiro {
+    Punto p[N];
+};
+
+constexpr double PI_CONST = 3.14159265358979323846;
+
+// Serie de Taylor: solo se evalúa al compilar
+constexpr double senoCompilacion(double a) {
+    while (a > PI_CONST) a -= 2 * PI_CONST;
+    while (a < -PI_CONST) a += 2 * PI_CONST;
+    double termino = a, suma = a;
+    for (int n = 1; n < 12; n++) {
+        termino *= -a * a / ((2 * n) * (2 * n + 1));
+        suma += termino;
+    }
+    return suma;
+}
+
+constexpr double cosenoCompilacion(double a) {
+    return senoCompilacion(a + PI_CONST / 2);
+}
+
+constexpr int16_t redondear(double v) {
+    return (int16_t)(v >= 0 ? v + 0.5 : v - 0.5);
+}
+
+// N posiciones empezando en 0 grados, de 'paso' en 'paso' grados,
+// redondeadas al píxel más cercano
+template <uint8_t N>
+constexpr TablaGiro<N> calcularGiro(int16_t cx, int16_t cy, int16_t radio, int16_t pasoGrados) {
+    TablaGiro<N> t{};
+    for (uint8_t i = 0; i < N; i++) {
+        double a = (double)(i * pasoGrados) * PI_CONST / 180.0;
+        t.p[i].x = redondear(cx + cosenoCompilacion(a) * radio);
+        t.p[i].y = redondear(cy + senoCompilacion(a) * radio);
+    }
+    return t;
+}
+
+#endif
@@ -0,0 +1,37 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Transporte de comandos (flujo de bytes)
+
+  Descripción:
+  Lo único que la tarea de control usa del enlace con el mando: saber si hay
+  un cliente, leer sin bloquear y escribir respuestas. Implementaciones:
+  - hal::EnlaceBT: BluetoothSerial en el ESP32; en el PC, cola que llena el
+    simulador (inyectar()) o un socket UDP.
+  - hal::TransporteSocket (solo PC): socket Unix de flujo; lo usan el
+    simulador en tiempo real y Herramientas/GeneradorCarga.cpp.
+  Mismas reglas que BluetoothSerial: available() y read() nunca bloquean,
+  read() devuelve -1 si no hay datos.
+  No depende de Arduino: compila también en el PC.
+  ============================================================================
+*/
+
+#ifndef TRANSPORTE_H
+#define TRANSPORTE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Transporte {
+public:
+    virtual ~Transporte() {}
+
+    virtual bool begin(const char* nombre) = 0;
+    virtual bool connected() = 0;
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual size_t write(const uint8_t* datos, size_t largo) = 0;
+};
+
+#endif
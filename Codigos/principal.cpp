@@ -9,8 +9,40 @@
   Características:
   - Animación de espera mientras no hay conexión Bluetooth
   - Animación de inicio al conectar Bluetooth
-  - Compensación de velocidad entre motores
-  - PWM nativo en pines de dirección (sin ENABLE)
+  - Animaciones por cuadros sin delay(): loop() nunca se bloquea (Animador.h)
+  - Dos tareas FreeRTOS: control de motores (núcleo 1, prioridad alta) y
+    pantalla (núcleo 0, prioridad baja), comunicadas por una cola sin
+    bloqueo (ColaSPSC.h). Una pantalla lenta nunca retrasa a los motores.
+  - Envío diferencial a la OLED: solo páginas/columnas modificadas (PantallaDiferencial.h)
+  - Flechas, círculos y posiciones de giro precalculados al compilar (Sprites.h)
+  - Control de motores a tasa fija (timer de hardware) con rampas de
+    aceleración en punto fijo (Rampa.h): sin inversiones bruscas
+  - Calibración por motor y sentido con tablas de 256 entradas (Calibracion.h),
+    cargables por Bluetooth y guardadas en memoria no volátil (NVS)
+  - PWM nativo en pines de dirección (sin ENABLE), con motores resueltos al
+    compilar (Motor.h): pines, inversión y calibración sin ramas en tiempo de ejecución
+  - Hardware detrás de Hal.h: el mismo código corre en el simulador de PC
+    (Herramientas/Simulador.cpp)
+  - Comandos por un Transporte (Transporte.h): BluetoothSerial en el robot,
+    socket Unix en el PC para pruebas de carga (Herramientas/GeneradorCarga.cpp)
+  - Vigilante (deadman) en un timer de hardware: si no llegan movimientos ni
+    BYTE_VIDA (0x16) en timeoutVigilante ms, su ISR pone los 4 canales PWM a 0
+    aunque la tarea de control esté bloqueada. Timeout ajustable con TRAMA_VIGILANTE
+  - Telemetría binaria opcional por Bluetooth (TRAMA_TELEMETRIA), en lotes;
+    Herramientas/DecodificarTelemetria.cpp la pasa a CSV. La tarea de control
+    no escribe en el enlace (puede bloquear): deja los bytes en una cola sin
+    bloqueo y la tarea de fondo los envía
+  - Parser de comandos incremental sin memoria dinámica (ParserComandos.h)
+  - Modo agrupado: cada pasada vacía el buffer Bluetooth; las velocidades se
+    aplican en orden y solo se muestra el último movimiento (ráfagas del joystick)
+  - Sondas de latencia con histogramas en RAM (Latencia.h); se eliminan al
+    compilar con MEDIR_LATENCIA 0
+  - Macros de manejo (Macro.h): se graban de los comandos del piloto, se
+    guardan en NVS y se reproducen desde el tick de control; cualquier
+    movimiento del piloto las interrumpe
+  - Registro diferido (Registro.h): los mensajes se guardan en binario en un
+    anillo en RAM y una tarea de baja prioridad los envía por Serial. Niveles
+    al compilar con NIVEL_REGISTRO (el eco "RX:" es de depuración)
   - COMANDOS ADICIONALES:
     - 'C1XXX': Establece velocidad para Motor 1 (Izquierdo), XXX = 000-255
     - 'C2XXX': Establece velocidad para Motor 2 (Derecho), XXX = 000-255
@@ -24,27 +56,58 @@
     - 'U', 'D', 'L', 'R': Movimientos generales (usan generalSpeed)
     - 'S': Detener ambos motores
     - 'X': Prueba de Pantalla OLED
+    - 'M': Informe por Bluetooth: latencias por etapa (p50/p99/max), contadores y arranque
+    - 'MB': Borrar las latencias medidas
+    - 'G0'..'G3': Grabar macro en esa ranura, 'GS': terminar y guardar en NVS
+    - 'P0'..'P3': Reproducir macro
+  - TRAMAS BINARIAS (ver ProtocoloBinario.h), detectadas por el byte 0xA5:
+    - TRAMA_MANEJO: duty con signo de ambos motores en un solo paquete
+    - TRAMA_VIGILANTE: timeout del vigilante en ms (20-5000)
+    - TRAMA_TELEMETRIA_CONFIG: periodo de telemetría (0 = apagada) y muestras por lote
+    - TRAMA_ANALOGICO: acelerador y giro proporcionales, mezclados por rueda
+      en punto fijo con curvas expo (Mezclador.h)
+    - TRAMA_MEZCLA: expo de acelerador y giro, guardadas en NVS
+    - TRAMA_CALIBRACION / TRAMA_CALIBRACION_FIN: carga de tablas de calibración
+  - Arranque rápido: motores parados y Bluetooth anunciándose antes que nada;
+    la pantalla se inicia en su tarea y, si falla, se reintenta sin detener
+    al robot. Velocidades, calibración, mezcla y macros se guardan en NVS juntando
+    los cambios (una escritura cuando dejan de llegar). El tiempo hasta quedar
+    listo se informa por Serial y con 'M'
   ============================================================================
 */
 
-#include <BluetoothSerial.h>
-#include <Wire.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
+#include <atomic>
+#include "Hal.h"
+#include "Configuracion.h"
+#include "ParserComandos.h"
+#include "Animador.h"
+#include "ColaSPSC.h"
+#include "Sprites.h"
+#include "Rampa.h"
+#include "Calibracion.h"
+#include "Mezclador.h"
+#include "Motor.h"
+#include "Macro.h"
 
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
-BluetoothSerial SerialBT;
+// Sondas de latencia (comandos 'M'/'MB'). Con 0 no generan código: usar en partido
+#ifndef MEDIR_LATENCIA
+#define MEDIR_LATENCIA 1
+#endif
+#include "Latencia.h"
 
-// Configuración de motores (PWM en pines de dirección)
+// Mensajes por Serial: NIVEL_REG_DEPURACION agrega el eco de cada comando; NIVEL_REG_NADA los quita todos
+#ifndef NIVEL_REGISTRO
+#define NIVEL_REGISTRO NIVEL_REG_INFO
+#endif
+#include "Registro.h"
 
-#define M1_IN1_CHANNEL 4  // GPIO4 - Motor Derecho IN1
-#define M1_IN2_CHANNEL 2  // GPIO2 - Motor Derecho IN2
-#define M2_IN1_CHANNEL 27 // GPIO27 - Motor Izquierdo IN3
-#define M2_IN2_CHANNEL 26 // GPIO26 - Motor Izquierdo IN4
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+hal::Pantalla<SCREEN_WIDTH, SCREEN_HEIGHT> display; // Solo envía por I2C lo que cambió
+hal::EnlaceBT SerialBT;
+Transporte* enlace = &SerialBT; // Transporte de los comandos; el simulador puede cambiarlo antes de setup()
 
-// Parámetros PWM
+// Parámetros PWM (pines de los motores en Configuracion.h)
 const uint32_t pwmFreq = 30000; 
 const uint8_t pwmResolution = 8; // 0-255
 
@@ -52,132 +115,422 @@ const uint8_t pwmResolution = 8; // 0-255
 uint8_t motor1Speed = 250;      // Velocidad Motor Derecho (para control individual F1/B1)
 uint8_t motor2Speed = 250;      // Velocidad Motor Izquierdo (para control individual F2/B2)
 uint8_t generalSpeed = 250;     // Velocidad para movimientos generales (U, D, L, R)
-const int8_t compensation = 0; // Compensación para el motor derecho. Si M1 es más lento, usa un valor positivo. Si es más rápido, negativo.
+const int8_t compensation = 0; // Compensación por defecto para el motor derecho (sin calibración guardada). Si M1 es más lento, usa un valor positivo. Si es más rápido, negativo.
+
+// Calibración: velocidad pedida -> duty real, por motor (0 = derecho, 1 = izquierdo) y sentido
+TablasCalibracion calibracion;
+TablasCalibracion calibracionPendiente; // Se completa por Bluetooth y se aplica con TRAMA_CALIBRACION_FIN
+Preferences preferencias;
+const char* claveCalibracion = "cal";
+
+// Persistencia: los cambios se juntan y la tarea de fondo los escribe cuando dejan de llegar,
+// así una ráfaga de comandos C no desgasta la flash ni bloquea la tarea de control
+enum CambioNvs : uint8_t {
+    NVS_VELOCIDADES = 1,
+    NVS_CALIBRACION = 2,        // Guardar 'calibracionGuardar'
+    NVS_CALIBRACION_BORRAR = 4, // Volver a la calibración por defecto
+    NVS_MACRO = 8,              // Guardar las ranuras de 'ranurasMacroNvs'
+    NVS_MEZCLA = 16
+};
+struct VelocidadesGuardadas {
+    uint8_t motor1;
+    uint8_t motor2;
+    uint8_t general;
+};
+const char* claveVelocidades = "vel";
+const char* claveMezcla = "mez";
+std::atomic<uint8_t> cambiosNvs{0};
+std::atomic<uint32_t> primerCambioNvs{0};
+std::atomic<uint32_t> ultimoCambioNvs{0};
+std::atomic<uint32_t> versionCalibracion{0}; // Impar mientras la tarea de control modifica 'calibracionGuardar'
+std::atomic<uint8_t> ranurasMacroNvs{0};    // Bit i: la macro i cambió
+std::atomic<uint32_t> versionMacros{0};      // Impar mientras la tarea de control modifica 'macros'
+VelocidadesGuardadas velocidadesEnNvs;
+ConfigMezcla mezclaEnNvs;
+TablasCalibracion calibracionGuardar;        // Tablas de la última CAL_GUARDAR, copiadas al recibirla
+TablasCalibracion calibracionNvs;            // Copia estable de 'calibracionGuardar' para escribirla
+
+// Arranque: us desde el reinicio hasta poder manejar y hasta tener pantalla
+uint32_t arranqueListoUs = 0;
+uint32_t pantallaListaUs = 0;
+bool pantallaLista = false;
+uint32_t proximoIntentoPantalla = 0;
+const uint32_t reintentoPantalla = 5000; // ms
 
 bool connectedBefore = false;
 unsigned long lastCommandTime = 0;
-const unsigned long commandTimeout = 700; // ms - Detener motores si no hay comandos en este tiempo
+
+ParserComandos parser;
+unsigned long lastByteTime = 0;
+const unsigned long lineTimeout = 50; // ms - Cerrar una línea sin '\n' tras este tiempo sin datos
+
+// Mando analógico: curvas expo (Q8) de acelerador y giro; se ajustan con TRAMA_MEZCLA
+ConfigMezcla configMezcla = { 64, 96 };
+
+// Modo agrupado: vaciar el buffer en cada pasada en vez de un comando por pasada
+bool agruparComandos = true;
+uint32_t comandosAgrupados = 0; // Movimientos reemplazados por otro de la misma pasada
+char flechaLetra = '\0';        // Última flecha enviada a la pantalla, para no redibujarla
+char flechaObjetivo = '\0';
+
+Animador animador;
+unsigned long lastLoopMicros = 0;
+unsigned long maxLoopPeriod = 0;          // us - Peor periodo de la tarea de control en la ventana actual
+unsigned long lastLoopReport = 0;
+const unsigned long loopReportInterval = 5000; // ms
+
+// Tareas: el control de motores tiene su propio núcleo; la pantalla (I2C lento) va en el otro
+const uint8_t nucleoControl = 1;
+const uint8_t nucleoUI = 0;
+const uint8_t prioridadControl = 5;
+const uint8_t prioridadUI = 1;
+const uint8_t prioridadFondo = 0; // Registro y NVS: solo corre cuando control y pantalla esperan
+
+// Eventos de la tarea de control hacia la tarea de pantalla
+enum TipoEventoUI : uint8_t {
+    UI_CONECTADO,
+    UI_DESCONECTADO,
+    UI_FLECHA,            // letra/objetivo como en drawArrow()
+    UI_VELOCIDAD_GENERAL, // valor = generalSpeed
+    UI_PRUEBA_PANTALLA,
+    UI_TIMEOUT            // STOP por timeout: no interrumpe animaciones
+};
+
+struct EventoUI {
+    TipoEventoUI tipo;
+    char letra;
+    char objetivo;
+    uint8_t valor;
+};
+
+// Rampa de los motores: 0 -> 255 en 150 ms, pendiente máxima alcanzada en 50 ms
+const ConfigRampa configRampa = configurarRampa(150, 50, frecuenciaControl);
+
+// Motores: velocidad con signo -> rampa -> tabla de calibración de cada motor (cada tick) -> LEDC
+typedef Motor<M1_IN1_CHANNEL, M1_IN2_CHANNEL, RasgosMotor<false, CompensacionTabla<&calibracion, 0> > > MotorDerecho;
+typedef Motor<M2_IN1_CHANNEL, M2_IN2_CHANNEL, RasgosMotor<false, CompensacionTabla<&calibracion, 1> > > MotorIzquierdo;
+DiffDrive<MotorDerecho, MotorIzquierdo> ruedas;
+
+// Vigilante: lo alimentan los movimientos y BYTE_VIDA (pines y valor inicial en Configuracion.h)
+uint16_t timeoutVigilante = timeoutVigilanteInicial; // ms
+
+// Telemetría: una muestra cada periodoTelemetria ms; se envían muestrasPorLote tramas
+// juntas en una sola escritura para no intercalar paquetes con los comandos entrantes
+uint16_t periodoTelemetria = 0; // ms, 0 = apagada
+uint8_t muestrasPorLote = 5;
+uint8_t loteTelemetria[TELEMETRIA_LOTE_MAX * TRAMA_TELEMETRIA_BYTES];
+uint8_t muestrasEnLote = 0;
+uint8_t seqTelemetria = 0;
+ColaSPSC<uint8_t, 1024> colaTx; // Control -> fondo: bytes para el enlace, en mensajes enteros
+uint32_t bytesTxPerdidos = 0;  // Cola llena: el enlace no da abasto
+unsigned long ultimaMuestra = 0;
+unsigned long periodoMaxTelemetria = 0; // us - Peor periodo de control desde la última muestra
+uint32_t comandosDescartados = 0;      // CMD_ERROR recibidos
+
+// Macros: ranuras en RAM (copia de NVS); la reproducción la avanza el tick de control
+Macro macros[MACROS_MAX];
+Macro macrosNvs[MACROS_MAX]; // Copia estable de las ranuras a escribir (tarea de fondo)
+const char* const clavesMacro[MACROS_MAX] = { "m0", "m1", "m2", "m3" };
+GrabadorMacro grabadorMacro;
+ReproductorMacro reproductorMacro;
+uint8_t ranuraGrabacion = 0;
+
+ColaSPSC<EventoUI, 32> colaUI;
+uint32_t eventosUIPerdidos = 0; // Cola llena: la pantalla no da abasto
+
+// Registro: formatos de los mensajes, en el mismo orden que MensajeRegistro
+enum MensajeRegistro : uint8_t {
+    REG_PANTALLA_ERROR,
+    REG_LISTO,
+    REG_PANTALLA_LISTA,
+    REG_VELOCIDADES_CARGADAS,
+    REG_VELOCIDADES_GUARDADAS,
+    REG_CAL_CARGADA,
+    REG_CAL_FUERA_RANGO,
+    REG_CAL_APLICADA,
+    REG_CAL_GUARDADA,
+    REG_CAL_DEFECTO,
+    REG_CAL_ENTRADA_CERO,
+    REG_TELEMETRIA,
+    REG_TELEMETRIA_FUERA_RANGO,
+    REG_VIGILANTE,
+    REG_VIGILANTE_FUERA_RANGO,
+    REG_MEZCLA,
+    REG_MEZCLA_CARGADA,
+    REG_MEZCLA_GUARDADA,
+    REG_TRAMA_DESCONOCIDA,
+    REG_RX,
+    REG_VEL_M1,
+    REG_VEL_M2,
+    REG_VEL_GENERAL,
+    REG_VEL_FUERA_RANGO,
+    REG_C_INCOMPLETO,
+    REG_FBS_MALFORMADO,
+    REG_TRAMA_CORRUPTA,
+    REG_TRAMA_MALFORMADA,
+    REG_DESCONOCIDO,
+    REG_PERIODO_MAX,
+    REG_UI_PERDIDOS,
+    REG_AGRUPADOS,
+    REG_TIMEOUT_BT,
+    REG_VIGILANTE_STOP,
+    REG_MACROS_CARGADAS,
+    REG_MACRO_GRABANDO,
+    REG_MACRO_GUARDADA,
+    REG_MACRO_INCOMPLETA,
+    REG_MACRO_SIN_CONSIGNAS,
+    REG_MACRO_RANURA,
+    REG_MACRO_VACIA,
+    REG_MACRO_INICIO,
+    REG_MACRO_INTERRUMPIDA,
+    REG_TX_LLENA,
+    REG_MENSAJES
+};
+const char* const formatosRegistro[REG_MENSAJES] = {
+    "Error inicializando pantalla OLED (reintento en %u ms)",
+    "ESP32 Bluetooth Car Listo en %u us. Esperando conexión...",
+    "Pantalla lista en %u us",
+    "Velocidades cargadas de NVS (general %u)",
+    "Velocidades guardadas en NVS",
+    "Calibracion cargada de NVS",
+    "Calibracion fuera de rango.",
+    "Calibracion aplicada",
+    "Calibracion guardada",
+    "Calibracion por defecto",
+    "Calibracion: entrada 0 distinta de 0, corregida",
+    "Telemetria (ms): %u",
+    "Telemetria fuera de rango.",
+    "Vigilante (ms): %u",
+    "Vigilante fuera de rango.",
+    "Mezcla: expo acelerador %u, giro %u",
+    "Mezcla cargada de NVS: expo acelerador %u, giro %u",
+    "Mezcla guardada en NVS",
+    "Trama binaria desconocida.",
+    "RX: %s",
+    "M1(Ind) Vel: %u",
+    "M2(Ind) Vel: %u",
+    "Vel. General: %u",
+    "Vel. fuera de rango (0-255).",
+    "Comando C incompleto.",
+    "Comando F/B/S malformado.",
+    "Trama binaria corrupta.",
+    "Trama binaria malformada.",
+    "Comando Desconocido: %s",
+    "Periodo max control (us): %u",
+    "Eventos UI perdidos: %u",
+    "Comandos agrupados: %u",
+    "Timeout BT -> STOP",
+    "Vigilante -> STOP",
+    "Macros cargadas de NVS: %u",
+    "Grabando macro %u",
+    "Macro %u guardada (%u pasos)",
+    "Macro llena: se descartaron consignas",
+    "Macro sin consignas",
+    "Macro fuera de rango: %u",
+    "Macro %u vacia",
+    "Macro %u",
+    "Macro interrumpida",
+    "Cola de envio llena: %u bytes descartados"
+};
+Registro<64> registro;
+uint32_t registrosPerdidosInformados = 0;
+
+#if MEDIR_LATENCIA
+enum EtapaLatencia : uint8_t {
+    LAT_RECEPCION,   // available() + read() de un byte
+    LAT_PARSEO,      // parser.alimentar() de un byte
+    LAT_EJECUCION,   // ejecutarComando(), incluido el registro
+    LAT_COMANDO_PWM, // Comando ejecutado -> primera escritura LEDC que provoca
+    LAT_ACTUACION,   // actualizarMotores()
+    LAT_RENDER,      // Evento o cuadro de animación dibujado (tarea de pantalla)
+    LAT_JITTER,      // |periodo real - periodo nominal| del tick de control, en us
+    LAT_ETAPAS
+};
+const char* const nombresLatencia[LAT_ETAPAS] = { "Recepcion", "Parseo", "Ejecucion", "Cmd->PWM", "Actuacion", "Render", "Jitter" };
+Histograma latencias[LAT_ETAPAS]; // En ciclos de CPU, salvo LAT_JITTER
+uint32_t cicloComando = 0;        // Inicio del último comando que cambió el objetivo de un motor
+bool comandoPendientePwm = false;
+#endif
+
+void tareaControl(void*);
+void tareaUI(void*);
+void tareaFondo(void*);
+void pasoTareaFondo();
+void cargarVelocidades();
+void cargarMezcla();
+void cargarCalibracion();
+void cargarMacros();
 
 void setup() {
+    // Primero lo que deja al robot seguro y manejable: motores parados y Bluetooth anunciándose
+    ruedas.iniciar(pwmFreq, pwmResolution);
+    hal::iniciarVigilante(pinesMotores, sizeof(pinesMotores), timeoutVigilante);
     Serial.begin(115200);
+    registro.reloj = hal::millis;
+    enlace->begin("RoboCodelabCar");
 
-    if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
-        Serial.println("Error inicializando pantalla OLED");
-        while(1);
-    }
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setTextColor(SSD1306_WHITE);
-    display.setCursor(0, 0);
-    display.println("Esperando BT...");
-    display.display();
+    // Los comandos que lleguen mientras tanto esperan en el buffer Bluetooth
+    preferencias.begin("futbot", false);
+    cargarVelocidades();
+    cargarMezcla();
+    cargarCalibracion();
+    cargarMacros();
+
+    hal::crearTarea(tareaControl, "Control", 4096, prioridadControl, nucleoControl);
+    arranqueListoUs = hal::micros();
+    REG_INFO(REG_LISTO, arranqueListoUs);
+
+    // La pantalla se inicia en su propia tarea (ver pasoTareaUI)
+    hal::crearTarea(tareaUI, "UI", 4096, prioridadUI, nucleoUI);
+    hal::crearTarea(tareaFondo, "Fondo", 4096, prioridadFondo, nucleoUI);
+}
+
+// ---------------------------------------------------------------------------
+// Tarea de pantalla: única dueña de 'display' y de las animaciones
+// ---------------------------------------------------------------------------
 
-    ledcAttach(M1_IN1_CHANNEL, pwmFreq, pwmResolution);
-    ledcAttach(M1_IN2_CHANNEL, pwmFreq, pwmResolution);
-    ledcAttach(M2_IN1_CHANNEL, pwmFreq, pwmResolution);
-    ledcAttach(M2_IN2_CHANNEL, pwmFreq, pwmResolution);
-    
+// Geometría fija precalculada al compilar (Sprites.h)
+#define CX (SCREEN_WIDTH / 2)
+#define CY (SCREEN_HEIGHT / 2)
+constexpr TablaGiro<30> giroEspera = calcularGiro<30>(CX, CY, SCREEN_HEIGHT / 2 - 12, 12); // 0..348 grados
+constexpr TablaGiro<15> giroInicio = calcularGiro<15>(CX, CY, 20, 25);                     // 0..350 grados
+constexpr Sprite<11, 11> circuloEspera = rasterizar<11, 11>(Circulo{0, 0, 5}, -5, -5);
+constexpr Sprite<7, 7> circuloInicio = rasterizar<7, 7>(Circulo{0, 0, 3}, -3, -3);
+// Flechas en un recuadro de 31x31 centrado en pantalla (mapeo invertido, ver drawArrow)
+constexpr Sprite<31, 31> flechaArriba = rasterizar<31, 31>(
+    Flecha{{CX, CY - 15, CX - 10, CY, CX + 10, CY}, {CX - 4, CY, 8, 15}}, CX - 15, CY - 15);
+constexpr Sprite<31, 31> flechaAbajo = rasterizar<31, 31>(
+    Flecha{{CX, CY + 15, CX - 10, CY, CX + 10, CY}, {CX - 4, CY - 15, 8, 15}}, CX - 15, CY - 15);
+constexpr Sprite<31, 31> flechaIzquierda = rasterizar<31, 31>(
+    Flecha{{CX - 15, CY, CX, CY - 10, CX, CY + 10}, {CX, CY - 4, 15, 8}}, CX - 15, CY - 15);
+constexpr Sprite<31, 31> flechaDerecha = rasterizar<31, 31>(
+    Flecha{{CX + 15, CY, CX, CY - 10, CX, CY + 10}, {CX - 15, CY - 4, 15, 8}}, CX - 15, CY - 15);
 
-    SerialBT.begin("RoboCodelabCar");
-    Serial.println("ESP32 Bluetooth Car Listo. Esperando conexión...");
+template <uint8_t W, uint8_t H>
+void dibujar(const Sprite<W, H>& sprite, int16_t dx = 0, int16_t dy = 0) {
+    dibujarSprite(display.getBuffer(), SCREEN_WIDTH, SCREEN_HEIGHT, sprite, dx, dy);
 }
 
-void animacionEsperaBT() {
-    static int angulo = 0;
+// Cada animación dibuja un cuadro por llamada (ver Animador.h)
+uint16_t animacionEsperaBT(uint16_t cuadro) {
+    const Punto& p = giroEspera.p[cuadro % 30];
     display.clearDisplay();
-    float angle_rad = angulo * PI / 180.0;
-    int x = SCREEN_WIDTH / 2 + cos(angle_rad) * (SCREEN_HEIGHT / 2 - 12);
-    int y = SCREEN_HEIGHT / 2 + sin(angle_rad) * (SCREEN_HEIGHT / 2 - 12);
-    display.fillCircle(x, y, 5, SSD1306_WHITE);
+    dibujar(circuloEspera, p.x, p.y);
     display.setTextSize(1);
     display.setCursor(10, SCREEN_HEIGHT - 10);
     display.print("Esperando BT...");
     display.display();
-    angulo = (angulo + 12) % 360;
+    return 40;
 }
 
-void animacionInicio() {
-    display.clearDisplay();
-    for(int i=0; i<360; i+=25) {
+uint16_t animacionInicio(uint16_t cuadro) {
+    const uint16_t cuadrosGiro = 15;                  // 0..350 grados de 25 en 25
+    const uint16_t cuadrosBarra = SCREEN_WIDTH / 5 + 1; // Ancho 0..125 de 5 en 5
+
+    if (cuadro < cuadrosGiro) {
+        const Punto& p = giroInicio.p[cuadro];
         display.clearDisplay();
-        float angle_rad = i * PI / 180.0;
-        int x = SCREEN_WIDTH / 2 + cos(angle_rad) * 20;
-        int y = SCREEN_HEIGHT / 2 + sin(angle_rad) * 20;
-        display.fillCircle(x, y, 3, SSD1306_WHITE);
+        dibujar(circuloInicio, p.x, p.y);
         display.setTextSize(1);
         display.setCursor(35, SCREEN_HEIGHT - 10); // Ajustado para centrar mejor
         display.print("Conectado!");
         display.display();
-        delay(25);
+        return 25;
+    }
+    cuadro -= cuadrosGiro;
+    if (cuadro < cuadrosBarra) {
+        display.fillRect(0, SCREEN_HEIGHT - 20, cuadro * 5, 8, SSD1306_WHITE);
+        display.display();
+        return 8;
     }
-    for(int i=0; i < SCREEN_WIDTH; i+=5) {
-        display.fillRect(0, SCREEN_HEIGHT - 20, i, 8, SSD1306_WHITE);
+    cuadro -= cuadrosBarra;
+    if (cuadro == 0) {
+        display.clearDisplay();
+        display.setTextSize(2);
+        // Centrar Texto "LISTO!"
+        int16_t x1, y1;
+        uint16_t w, h;
+        const char* listoStr = "LISTO!";
+        display.getTextBounds(listoStr, 0, 0, &x1, &y1, &w, &h);
+        display.setCursor((SCREEN_WIDTH - w) / 2, (SCREEN_HEIGHT - h) / 2);
+        display.print(listoStr);
         display.display();
-        delay(8);
+        return 500;
     }
+    display.clearDisplay(); 
+    display.display();
+    return ANIM_FIN;
+}
+
+uint16_t animacionPruebaPantalla(uint16_t cuadro) {
+    int16_t x1, y1; uint16_t w, h; // Para centrar texto
     display.clearDisplay();
-    display.setTextSize(2);
-    // Centrar Texto "LISTO!"
-    int16_t x1, y1;
-    uint16_t w, h;
-    String listoStr = "LISTO!";
-    display.getTextBounds(listoStr, 0, 0, &x1, &y1, &w, &h);
-    display.setCursor((SCREEN_WIDTH - w) / 2, (SCREEN_HEIGHT - h) / 2);
-    display.print(listoStr);
+    if (cuadro == 0) {
+        display.setTextSize(1); display.setCursor(0,0); display.println("Test Pantalla:");
+        display.drawRect(0, 10, SCREEN_WIDTH-1, SCREEN_HEIGHT-11, SSD1306_WHITE);
+        for(int i=0; i<60; i++) { 
+            display.drawPixel(random(1,SCREEN_WIDTH-2), random(11,SCREEN_HEIGHT-12), SSD1306_WHITE);
+        }
+        display.display();
+        return 1000;
+    }
+    if (cuadro == 1) {
+        display.setTextSize(2);
+        const char* oledOkStr = "OLED OK!";
+        display.getTextBounds(oledOkStr, 0, 0, &x1, &y1, &w, &h);
+        display.setCursor((SCREEN_WIDTH - w) / 2, (SCREEN_HEIGHT - h) / 2);
+        display.println(oledOkStr);
+        display.display();
+        return 800;
+    }
     display.display();
-    delay(500);
-    display.clearDisplay(); 
+    return ANIM_FIN;
+}
+
+uint16_t animacionDesconectado(uint16_t cuadro) {
+    if (cuadro > 0) return ANIM_FIN; // Luego loop() arranca animacionEsperaBT
+    display.clearDisplay(); display.setTextSize(1);
+    display.setCursor(15, 28); display.print("Desconectado!");
     display.display();
+    return 1000;
 }
 
-void drawArrow(const String& direction) {
+// direction: 'U', 'D', 'L', 'R', 'S', 'X' o 'F'/'B'/'S' con motorId '1'/'2'
+void drawArrow(char direction, char motorId = '\0') {
+    animador.detener(); // Un comando nuevo interrumpe cualquier animación
     display.clearDisplay();
     int16_t x1, y1; uint16_t w, h; // Para centrar texto
 
     // Mapeo invertido para corresponder con movimiento físico del carro en el display
     // Comando 'D' (Atrás general) -> Flecha Arriba en display
-    if(direction == "D") { 
-        display.fillTriangle(SCREEN_WIDTH/2, SCREEN_HEIGHT/2 - 15, SCREEN_WIDTH/2 - 10, SCREEN_HEIGHT/2, SCREEN_WIDTH/2 + 10, SCREEN_HEIGHT/2, SSD1306_WHITE);
-        display.fillRect(SCREEN_WIDTH/2 - 4, SCREEN_HEIGHT/2, 8, 15, SSD1306_WHITE); 
+    if(direction == 'D') { 
+        dibujar(flechaArriba);
     }
     // Comando 'U' (Adelante general) -> Flecha Abajo en display
-    else if(direction == "U") { 
-        display.fillTriangle(SCREEN_WIDTH/2, SCREEN_HEIGHT/2 + 15, SCREEN_WIDTH/2 - 10, SCREEN_HEIGHT/2, SCREEN_WIDTH/2 + 10, SCREEN_HEIGHT/2, SSD1306_WHITE);
-        display.fillRect(SCREEN_WIDTH/2 - 4, SCREEN_HEIGHT/2 - 15, 8, 15, SSD1306_WHITE);
+    else if(direction == 'U') { 
+        dibujar(flechaAbajo);
     }
     // Comando 'R' (Giro Derecha físico) -> Flecha Izquierda en display
-    else if(direction == "R") { 
-        display.fillTriangle(SCREEN_WIDTH/2 - 15, SCREEN_HEIGHT/2, SCREEN_WIDTH/2, SCREEN_HEIGHT/2 - 10, SCREEN_WIDTH/2, SCREEN_HEIGHT/2 + 10, SSD1306_WHITE);
-        display.fillRect(SCREEN_WIDTH/2, SCREEN_HEIGHT/2 - 4, 15, 8, SSD1306_WHITE);
+    else if(direction == 'R') { 
+        dibujar(flechaIzquierda);
     }
     // Comando 'L' (Giro Izquierda físico) -> Flecha Derecha en display
-    else if(direction == "L") { 
-        display.fillTriangle(SCREEN_WIDTH/2 + 15, SCREEN_HEIGHT/2, SCREEN_WIDTH/2, SCREEN_HEIGHT/2 - 10, SCREEN_WIDTH/2, SCREEN_HEIGHT/2 + 10, SSD1306_WHITE);
-        display.fillRect(SCREEN_WIDTH/2 - 15, SCREEN_HEIGHT/2 - 4, 15, 8, SSD1306_WHITE);
+    else if(direction == 'L') { 
+        dibujar(flechaDerecha);
     }
-    else if(direction == "X") {
-        display.setTextSize(1); display.setCursor(0,0); display.println("Test Pantalla:");
-        display.drawRect(0, 10, SCREEN_WIDTH-1, SCREEN_HEIGHT-11, SSD1306_WHITE);
-        for(int i=0; i<60; i++) { 
-            display.drawPixel(random(1,SCREEN_WIDTH-2), random(11,SCREEN_HEIGHT-12), SSD1306_WHITE);
-        }
-        display.display(); delay(1000);
-        display.clearDisplay(); display.setTextSize(2);
-        String oledOkStr = "OLED OK!";
-        display.getTextBounds(oledOkStr, 0, 0, &x1, &y1, &w, &h);
-        display.setCursor((SCREEN_WIDTH - w) / 2, (SCREEN_HEIGHT - h) / 2);
-        display.println(oledOkStr);
-        display.display(); delay(800); display.clearDisplay();
-    }
-    else if(direction == "F1") { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor DER: Adelante"); }
-    else if(direction == "B1") { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor DER: Atras"); }
-    else if(direction == "S1") { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor DER: STOP"); }
-    else if(direction == "F2") { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor IZQ: Adelante"); }
-    else if(direction == "B2") { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor IZQ: Atras"); }
-    else if(direction == "S2") { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor IZQ: STOP"); }
+    else if(direction == 'X') {
+        animador.iniciar(animacionPruebaPantalla, hal::millis());
+        return;
+    }
+    else if(direction == 'F' && motorId == '1') { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor DER: Adelante"); }
+    else if(direction == 'B' && motorId == '1') { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor DER: Atras"); }
+    else if(direction == 'S' && motorId == '1') { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor DER: STOP"); }
+    else if(direction == 'F' && motorId == '2') { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor IZQ: Adelante"); }
+    else if(direction == 'B' && motorId == '2') { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor IZQ: Atras"); }
+    else if(direction == 'S' && motorId == '2') { display.setTextSize(1); display.setCursor(10, 28); display.print("Motor IZQ: STOP"); }
     else { 
         display.setTextSize(2);
-        String stopStr = "STOP";
+        const char* stopStr = "STOP";
         display.getTextBounds(stopStr, 0, 0, &x1, &y1, &w, &h);
         display.setCursor((SCREEN_WIDTH - w) / 2, (SCREEN_HEIGHT - h) / 2);
         display.print(stopStr);
@@ -185,123 +538,719 @@ void drawArrow(const String& direction) {
     display.display();
 }
 
-void controlMotor1(char direction, uint8_t speedVal) {
-    uint16_t compensatedSpeed = speedVal; // Usar uint16_t temporalmente por si la compensación es grande
-    if (speedVal > 0) {
-        compensatedSpeed = speedVal + compensation;
-        if (compensatedSpeed > 255) compensatedSpeed = 255;
-        if (compensatedSpeed < 0) compensatedSpeed = 0; // Aunque uint no será negativo, por si acaso.
+void mostrarVelocidadGeneral(uint8_t velocidad) {
+    animador.detener();
+    display.clearDisplay(); display.setTextSize(1);
+    display.setCursor(5,20); display.print("Vel. General:");
+    display.setTextSize(2);
+    // Centrar el valor de la velocidad
+    int16_t x1, y1; uint16_t w, h;
+    char speedValStr[4];
+    snprintf(speedValStr, sizeof(speedValStr), "%u", velocidad);
+    display.getTextBounds(speedValStr, 0, 0, &x1, &y1, &w, &h);
+    display.setCursor((SCREEN_WIDTH - w) / 2, 35);
+    display.print(speedValStr);
+    display.display();
+}
+
+bool uiConectado = false;
+
+void procesarEventoUI(const EventoUI& ev) {
+    switch (ev.tipo) {
+        case UI_CONECTADO:
+            uiConectado = true;
+            animador.iniciar(animacionInicio, hal::millis());
+            break;
+        case UI_DESCONECTADO:
+            uiConectado = false;
+            animador.iniciar(animacionDesconectado, hal::millis());
+            break;
+        case UI_FLECHA: drawArrow(ev.letra, ev.objetivo); break;
+        case UI_VELOCIDAD_GENERAL: mostrarVelocidadGeneral(ev.valor); break;
+        case UI_PRUEBA_PANTALLA: drawArrow('X'); break;
+        case UI_TIMEOUT:
+            if (!animador.activa()) drawArrow('S'); // No cortar la animación de inicio
+            break;
     }
-    uint8_t finalSpeed = (uint8_t)compensatedSpeed;
+}
 
-    if (direction == 'F') { ledcWrite(M1_IN1_CHANNEL, finalSpeed); ledcWrite(M1_IN2_CHANNEL, 0); }
-    else if (direction == 'B') { ledcWrite(M1_IN1_CHANNEL, 0); ledcWrite(M1_IN2_CHANNEL, finalSpeed); }
-    else if (direction == 'S') { ledcWrite(M1_IN1_CHANNEL, 0); ledcWrite(M1_IN2_CHANNEL, 0); }
+// La OLED se inicia desde aquí: el arranque no la espera y, si no responde, el robot sigue sin ella
+bool iniciarPantalla() {
+    if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+        REG_ERROR(REG_PANTALLA_ERROR, reintentoPantalla);
+        return false;
+    }
+    display.clearDisplay();
+    display.setTextSize(1);
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(0, 0);
+    display.println("Esperando BT...");
+    display.display();
+    pantallaListaUs = hal::micros();
+    REG_INFO(REG_PANTALLA_LISTA, pantallaListaUs);
+    return true;
+}
+
+// Una pasada de la tarea de pantalla (el simulador la llama directamente)
+void pasoTareaUI() {
+    EventoUI ev;
+    if (!pantallaLista) {
+        if ((int32_t)(hal::millis() - proximoIntentoPantalla) >= 0) {
+            pantallaLista = iniciarPantalla();
+            proximoIntentoPantalla = hal::millis() + reintentoPantalla;
+        }
+        if (!pantallaLista) {
+            // Sin pantalla solo se sigue el estado de conexión, para dibujar bien si aparece
+            while (colaUI.desencolar(ev)) {
+                if (ev.tipo == UI_CONECTADO) uiConectado = true;
+                if (ev.tipo == UI_DESCONECTADO) uiConectado = false;
+            }
+            return;
+        }
+    }
+    while (colaUI.desencolar(ev)) {
+        SONDA_INICIO(tEvento);
+        procesarEventoUI(ev);
+        SONDA_FIN(LAT_RENDER, tEvento);
+    }
+    if (!uiConectado && !animador.activa()) animador.iniciar(animacionEsperaBT, hal::millis());
+    SONDA_INICIO(tCuadro);
+    if (animador.actualizar(hal::millis())) { // Como máximo un cuadro por pasada
+        SONDA_FIN(LAT_RENDER, tCuadro);
+    }
 }
 
-void controlMotor2(char direction, uint8_t speedVal) {
-    if (direction == 'F') { ledcWrite(M2_IN1_CHANNEL, speedVal); ledcWrite(M2_IN2_CHANNEL, 0); }
-    else if (direction == 'B') { ledcWrite(M2_IN1_CHANNEL, 0); ledcWrite(M2_IN2_CHANNEL, speedVal); }
-    else if (direction == 'S') { ledcWrite(M2_IN1_CHANNEL, 0); ledcWrite(M2_IN2_CHANNEL, 0); }
+void tareaUI(void*) {
+    for (;;) {
+        pasoTareaUI();
+        hal::dormirMs(periodoUI);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Tarea de fondo: envíos por el enlace, registro por Serial y escrituras en NVS
+// ---------------------------------------------------------------------------
+
+// Escribe en el enlace lo que dejó la tarea de control; aquí sí puede bloquear
+void pasoEnvio() {
+    uint8_t bloque[64];
+    size_t n;
+    while ((n = colaTx.desencolarVarios(bloque, sizeof(bloque))) > 0) enlace->write(bloque, n);
+}
+
+// Copia 'calibracionGuardar' si la tarea de control no la está cambiando (ver versionCalibracion)
+bool copiarCalibracion(TablasCalibracion& destino) {
+    uint32_t version = versionCalibracion.load();
+    if (version & 1) return false;
+    destino = calibracionGuardar;
+    return versionCalibracion.load() == version;
+}
+
+// Copia las ranuras de 'ranuras' si la tarea de control no está grabando en ellas (ver versionMacros)
+bool copiarMacros(uint8_t ranuras, Macro* destino) {
+    uint32_t version = versionMacros.load();
+    if (version & 1) return false;
+    for (uint8_t i = 0; i < MACROS_MAX; i++) {
+        if (ranuras & (1 << i)) destino[i] = macros[i];
+    }
+    return versionMacros.load() == version;
+}
+
+// Escribe los cambios pendientes cuando llevan esperaNvs sin repetirse (o esperaMaxNvs en total)
+void pasoPersistencia() {
+    uint8_t cambios = cambiosNvs.load();
+    if (cambios == 0) return;
+    uint32_t ahora = hal::millis();
+    if (ahora - ultimoCambioNvs.load() < esperaNvs && ahora - primerCambioNvs.load() < esperaMaxNvs) return;
+    if ((cambios & NVS_CALIBRACION) && !copiarCalibracion(calibracionNvs)) return; // Próxima pasada
+    uint8_t ranuras = (cambios & NVS_MACRO) ? ranurasMacroNvs.load() : 0;
+    if (ranuras != 0 && !copiarMacros(ranuras, macrosNvs)) return;
+    cambiosNvs.fetch_and((uint8_t)~cambios); // Lo que llegue desde aquí queda para la próxima escritura
+    ranurasMacroNvs.fetch_and((uint8_t)~ranuras);
+
+    if (cambios & NVS_VELOCIDADES) {
+        VelocidadesGuardadas v = { motor1Speed, motor2Speed, generalSpeed };
+        if (memcmp(&v, &velocidadesEnNvs, sizeof(v)) != 0) { // Volvieron al valor guardado: nada que escribir
+            preferencias.putBytes(claveVelocidades, &v, sizeof(v));
+            velocidadesEnNvs = v;
+            REG_INFO(REG_VELOCIDADES_GUARDADAS);
+        }
+    }
+    if (cambios & NVS_MEZCLA) {
+        ConfigMezcla m = configMezcla;
+        if (memcmp(&m, &mezclaEnNvs, sizeof(m)) != 0) {
+            preferencias.putBytes(claveMezcla, &m, sizeof(m));
+            mezclaEnNvs = m;
+            REG_INFO(REG_MEZCLA_GUARDADA);
+        }
+    }
+    if (cambios & NVS_CALIBRACION) {
+        preferencias.putBytes(claveCalibracion, &calibracionNvs, sizeof(calibracionNvs));
+        REG_INFO(REG_CAL_GUARDADA);
+    }
+    if (cambios & NVS_CALIBRACION_BORRAR) preferencias.remove(claveCalibracion);
+    for (uint8_t i = 0; i < MACROS_MAX; i++) {
+        if (ranuras & (1 << i)) preferencias.putBytes(clavesMacro[i], &macrosNvs[i], bytesMacro(macrosNvs[i]));
+    }
+}
+
+// Envía, vacía el anillo de registro y guarda lo pendiente (el simulador la llama directamente)
+void pasoTareaFondo() {
+    pasoEnvio();
+    pasoPersistencia();
+    RegistroBinario r;
+    char linea[96];
+    while (registro.extraer(r)) {
+        formatearRegistro(r, formatosRegistro, REG_MENSAJES, linea, sizeof(linea));
+        Serial.println(linea);
+    }
+    uint32_t perdidos = registro.perdidos();
+    if (perdidos != registrosPerdidosInformados) {
+        Serial.print("Registros perdidos: "); Serial.println(perdidos - registrosPerdidosInformados);
+        registrosPerdidosInformados = perdidos;
+    }
+}
+
+void tareaFondo(void*) {
+    for (;;) {
+        pasoTareaFondo();
+        hal::dormirMs(periodoFondo);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Tarea de control: Bluetooth, comandos, motores y timeout
+// ---------------------------------------------------------------------------
+
+void calibracionPorDefecto(TablasCalibracion& t) {
+    tablaCompensacion(t.tabla[indiceTabla(0, 0)], compensation);
+    tablaCompensacion(t.tabla[indiceTabla(0, 1)], compensation);
+    tablaCompensacion(t.tabla[indiceTabla(1, 0)], 0);
+    tablaCompensacion(t.tabla[indiceTabla(1, 1)], 0);
+}
+
+void cargarVelocidades() {
+    VelocidadesGuardadas v;
+    if (preferencias.getBytesLength(claveVelocidades) == sizeof(v)) {
+        preferencias.getBytes(claveVelocidades, &v, sizeof(v));
+        motor1Speed = v.motor1;
+        motor2Speed = v.motor2;
+        generalSpeed = v.general;
+        REG_INFO(REG_VELOCIDADES_CARGADAS, generalSpeed);
+    }
+    velocidadesEnNvs = { motor1Speed, motor2Speed, generalSpeed };
+}
+
+void cargarMezcla() {
+    if (preferencias.getBytesLength(claveMezcla) == sizeof(configMezcla)) {
+        preferencias.getBytes(claveMezcla, &configMezcla, sizeof(configMezcla));
+        REG_INFO(REG_MEZCLA_CARGADA, configMezcla.expoAcelerador, configMezcla.expoGiro);
+    }
+    mezclaEnNvs = configMezcla;
+}
+
+// Anota un cambio para pasoPersistencia(); guardar y borrar la calibración se excluyen
+void marcarCambioNvs(CambioNvs cambio) {
+    uint32_t ahora = hal::millis();
+    if (cambiosNvs.load() == 0) primerCambioNvs.store(ahora);
+    ultimoCambioNvs.store(ahora);
+    if (cambio == NVS_CALIBRACION) cambiosNvs.fetch_and((uint8_t)~NVS_CALIBRACION_BORRAR);
+    if (cambio == NVS_CALIBRACION_BORRAR) cambiosNvs.fetch_and((uint8_t)~NVS_CALIBRACION);
+    cambiosNvs.fetch_or(cambio);
+}
+
+// Solo desde la tarea de control. Las tablas se copian al recibir CAL_GUARDAR: una CAL_APLICAR
+// (solo prueba) que llegue antes de la escritura no cambia lo que se guarda
+void guardarCalibracion(const TablasCalibracion& t) {
+    versionCalibracion.fetch_add(1); // La tarea de fondo puede estar copiándolas
+    calibracionGuardar = t;
+    versionCalibracion.fetch_add(1);
+    marcarCambioNvs(NVS_CALIBRACION); // Se escribe desde la tarea de fondo
+}
+
+void cargarCalibracion() {
+    if (preferencias.getBytesLength(claveCalibracion) == sizeof(calibracion)) {
+        preferencias.getBytes(claveCalibracion, &calibracion, sizeof(calibracion));
+        REG_INFO(REG_CAL_CARGADA);
+        if (corregirEntradaCero(calibracion)) REG_AVISO(REG_CAL_ENTRADA_CERO);
+    } else {
+        calibracionPorDefecto(calibracion);
+    }
+    calibracionPendiente = calibracion;
+}
+
+void cargarMacros() {
+    uint32_t cargadas = 0;
+    for (uint8_t i = 0; i < MACROS_MAX; i++) {
+        size_t bytes = preferencias.getBytesLength(clavesMacro[i]);
+        macros[i].cantidad = 0;
+        if (bytes == 0 || bytes > sizeof(Macro)) continue;
+        preferencias.getBytes(clavesMacro[i], &macros[i], bytes);
+        if (macroValida(macros[i], bytes)) cargadas++;
+        else macros[i].cantidad = 0;
+    }
+    if (cargadas > 0) REG_INFO(REG_MACROS_CARGADAS, cargadas);
+}
+
+// Letra de dirección de los comandos ASCII -> velocidad con signo
+int16_t velocidadConSigno(char direction, uint8_t speedVal) {
+    if (direction == 'F') return speedVal;
+    if (direction == 'B') return -(int16_t)speedVal;
+    return 0;
 }
 
 void moveMotorsGeneral(char command) {
+    int16_t v = generalSpeed;
     switch(command) {
-        case 'U': controlMotor1('F', generalSpeed); controlMotor2('F', generalSpeed); break;
-        case 'D': controlMotor1('B', generalSpeed); controlMotor2('B', generalSpeed); break;
-        case 'L': controlMotor1('B', generalSpeed); controlMotor2('F', generalSpeed); break; // Izquierda físico
-        case 'R': controlMotor1('F', generalSpeed); controlMotor2('B', generalSpeed); break; // Derecha físico
-        case 'S': controlMotor1('S', 0); controlMotor2('S', 0); break;
+        case 'U': ruedas.fijar(v, v); break;
+        case 'D': ruedas.fijar(-v, -v); break;
+        case 'L': ruedas.fijar(-v, v); break; // Izquierda físico
+        case 'R': ruedas.fijar(v, -v); break; // Derecha físico
+        case 'S': ruedas.fijar(0, 0); break;
     }
 }
 
-void loop() {
-    if (SerialBT.connected()) {
+// Un tick de rampa para ambos motores; solo escribe el LEDC si el duty cambió
+void actualizarMotores() {
+    bool escrito = ruedas.actualizar(configRampa);
+#if MEDIR_LATENCIA
+    if (comandoPendientePwm && escrito) {
+        latencias[LAT_COMANDO_PWM].registrar(hal::ciclos() - cicloComando);
+        comandoPendientePwm = false;
+    }
+#else
+    (void)escrito;
+#endif
+}
+
+// Parada de seguridad (timeout, desconexión, vigilante): sin rampa y sin macro
+void detenerMotores() {
+    reproductorMacro.cancelar();
+    ruedas.detener();
+}
+
+void enviarUI(TipoEventoUI tipo, char letra = '\0', char objetivo = '\0', uint8_t valor = 0) {
+    if (tipo == UI_FLECHA) {
+        if (agruparComandos && letra == flechaLetra && objetivo == flechaObjetivo) return; // Ya está en pantalla
+        flechaLetra = letra;
+        flechaObjetivo = objetivo;
+    } else {
+        flechaLetra = flechaObjetivo = '\0'; // Cualquier otro evento cambia la pantalla
+    }
+    EventoUI ev = { tipo, letra, objetivo, valor };
+    if (!colaUI.encolar(ev)) eventosUIPerdidos++;
+}
+
+void procesarTrama(const Trama& trama) {
+    if (trama.tipo == TRAMA_CALIBRACION && trama.largo >= 3) {
+        uint8_t tabla = trama.datos[0];
+        uint16_t posicion = trama.datos[1];
+        uint8_t cantidad = trama.largo - 2;
+        if (tabla < CAL_TABLAS && posicion + cantidad <= 256) {
+            memcpy(&calibracionPendiente.tabla[tabla][posicion], &trama.datos[2], cantidad);
+        } else { REG_AVISO(REG_CAL_FUERA_RANGO); }
+    } else if (trama.tipo == TRAMA_CALIBRACION_FIN && trama.largo == 1) {
+        switch (trama.datos[0]) {
+            case CAL_APLICAR:
+            case CAL_GUARDAR:
+                if (corregirEntradaCero(calibracionPendiente)) REG_AVISO(REG_CAL_ENTRADA_CERO);
+                calibracion = calibracionPendiente;
+                if (trama.datos[0] == CAL_GUARDAR) guardarCalibracion(calibracionPendiente);
+                REG_INFO(REG_CAL_APLICADA);
+                break;
+            case CAL_RESTAURAR:
+                calibracionPorDefecto(calibracionPendiente);
+                calibracion = calibracionPendiente;
+                marcarCambioNvs(NVS_CALIBRACION_BORRAR);
+                REG_INFO(REG_CAL_DEFECTO);
+                break;
+        }
+    } else if (trama.tipo == TRAMA_TELEMETRIA_CONFIG && trama.largo == TRAMA_TELEMETRIA_CONFIG_LARGO) {
+        uint16_t periodo = leerUint16(trama.datos);
+        uint8_t lote = trama.datos[2];
+        if ((periodo == 0 || periodo >= TELEMETRIA_MS_MIN) && lote >= 1 && lote <= TELEMETRIA_LOTE_MAX) {
+            periodoTelemetria = periodo;
+            muestrasPorLote = lote;
+            muestrasEnLote = 0; // El lote a medio llenar se descarta
+            ultimaMuestra = hal::millis();
+            REG_INFO(REG_TELEMETRIA, periodo);
+        } else { REG_AVISO(REG_TELEMETRIA_FUERA_RANGO); }
+    } else if (trama.tipo == TRAMA_VIGILANTE && trama.largo == TRAMA_VIGILANTE_LARGO) {
+        uint16_t ms = leerUint16(trama.datos);
+        if (ms >= VIGILANTE_MS_MIN && ms <= VIGILANTE_MS_MAX) {
+            timeoutVigilante = ms;
+            hal::fijarTimeoutVigilante(ms);
+            REG_INFO(REG_VIGILANTE, ms);
+        } else { REG_AVISO(REG_VIGILANTE_FUERA_RANGO); }
+    } else if (trama.tipo == TRAMA_MEZCLA && trama.largo == TRAMA_MEZCLA_LARGO) {
+        configMezcla.expoAcelerador = trama.datos[0]; // Todo 0..255 es válido
+        configMezcla.expoGiro = trama.datos[1];
+        marcarCambioNvs(NVS_MEZCLA);
+        REG_INFO(REG_MEZCLA, configMezcla.expoAcelerador, configMezcla.expoGiro);
+    } else { REG_AVISO(REG_TRAMA_DESCONOCIDA); }
+}
+
+// Deja un mensaje entero para la tarea de fondo; si no cabe se descarta completo
+void encolarEnvio(const uint8_t* datos, size_t largo) {
+    if (colaTx.encolarTodos(datos, largo)) return;
+    bytesTxPerdidos += largo;
+    REG_AVISO(REG_TX_LLENA, largo);
+}
+
+// Respuesta por el enlace (la envía la tarea de fondo)
+void enviarTexto(const char* texto) {
+    encolarEnvio((const uint8_t*)texto, strlen(texto));
+}
+
+// Una línea por etapa con p50/p99/max; las duraciones en ns y el jitter en us
+void reportarLatencias() {
+    char linea[96];
+#if MEDIR_LATENCIA
+    uint32_t ciclosUs = hal::ciclosPorUs();
+    for (uint8_t i = 0; i < LAT_ETAPAS; i++) {
+        const Histograma& h = latencias[i];
+        uint32_t mult = (i == LAT_JITTER) ? 1 : 1000;
+        uint32_t div = (i == LAT_JITTER) ? 1 : ciclosUs;
+        snprintf(linea, sizeof(linea), "%-10s n=%lu p50=%lu p99=%lu max=%lu %s\n", nombresLatencia[i],
+                 (unsigned long)h.cantidad(),
+                 (unsigned long)((uint64_t)h.percentil(50) * mult / div),
+                 (unsigned long)((uint64_t)h.percentil(99) * mult / div),
+                 (unsigned long)((uint64_t)h.maximoValor() * mult / div),
+                 i == LAT_JITTER ? "us" : "ns");
+        enviarTexto(linea);
+    }
+#else
+    enviarTexto("Latencias desactivadas (MEDIR_LATENCIA 0)\n");
+#endif
+    // Contadores y arranque: se miden siempre
+    snprintf(linea, sizeof(linea), "Agrupados  n=%lu\n", (unsigned long)comandosAgrupados);
+    enviarTexto(linea);
+    snprintf(linea, sizeof(linea), "TxPerdido  bytes=%lu\n", (unsigned long)bytesTxPerdidos);
+    enviarTexto(linea);
+    snprintf(linea, sizeof(linea), "Arranque   listo=%lu pantalla=%lu us\n", (unsigned long)arranqueListoUs,
+             (unsigned long)pantallaListaUs);
+    enviarTexto(linea);
+}
+
+// Cada histograma se vacía en su próximo registro, desde la tarea que lo escribe
+void borrarLatencias() {
+#if MEDIR_LATENCIA
+    for (uint8_t i = 0; i < LAT_ETAPAS; i++) latencias[i].pedirReinicio();
+    enviarTexto("Latencias borradas\n");
+#endif
+}
+
+// G<n>: grabar en la ranura n, GS: terminar y guardar, P<n>: reproducir
+void comandoMacro(const Comando& cmd) {
+    if (cmd.letra == 'G' && cmd.objetivo == 'S') {
+        if (!grabadorMacro.activo()) return;
+        bool incompleta = grabadorMacro.incompleta();
+        Macro& m = macros[ranuraGrabacion];
+        versionMacros.fetch_add(1);
+        bool grabada = grabadorMacro.terminar(hal::millis(), m);
+        versionMacros.fetch_add(1);
+        if (!grabada) { REG_AVISO(REG_MACRO_SIN_CONSIGNAS); return; }
+        reproductorMacro.cancelar(); // Podría estar leyendo la ranura que se reemplaza
+        ranurasMacroNvs.fetch_or((uint8_t)(1 << ranuraGrabacion));
+        marcarCambioNvs(NVS_MACRO); // Se escribe desde la tarea de fondo
+        REG_INFO(REG_MACRO_GUARDADA, ranuraGrabacion, m.cantidad);
+        if (incompleta) REG_AVISO(REG_MACRO_INCOMPLETA);
+        return;
+    }
+    uint8_t ranura = cmd.objetivo - '0';
+    if (ranura >= MACROS_MAX) { REG_AVISO(REG_MACRO_RANURA, ranura); return; }
+    if (cmd.letra == 'G') {
+        ranuraGrabacion = ranura;
+        grabadorMacro.iniciar();
+        REG_INFO(REG_MACRO_GRABANDO, ranura);
+        return;
+    }
+    if (macros[ranura].cantidad == 0) { REG_AVISO(REG_MACRO_VACIA, ranura); return; }
+    reproductorMacro.iniciar(macros[ranura], hal::millis());
+    REG_INFO(REG_MACRO_INICIO, ranura);
+}
+
+bool esMovimiento(const Comando& cmd) {
+    return cmd.tipo == CMD_MOTOR || cmd.tipo == CMD_GENERAL || cmd.tipo == CMD_MANEJO || cmd.tipo == CMD_ANALOGICO;
+}
+
+// Eco y flecha de un movimiento (las tramas de manejo no tienen: son de alta frecuencia)
+void mostrarMovimiento(const Comando& cmd) {
+    if (cmd.tipo == CMD_MANEJO || cmd.tipo == CMD_ANALOGICO) return;
+#if NIVEL_REGISTRO >= NIVEL_REG_DEPURACION
+    const char texto[3] = { cmd.letra, cmd.objetivo, '\0' };
+    REG_DEPURACION(REG_RX, texto);
+#endif
+    enviarUI(UI_FLECHA, cmd.letra, cmd.objetivo);
+}
+
+// mostrar = false: el movimiento se aplica a los motores sin eco ni dibujo (modo agrupado)
+void ejecutarComando(const Comando& cmd, bool mostrar) {
+    if (cmd.tipo == CMD_MANEJO) {
+        // Ambas ruedas en la misma actualización
+        ruedas.fijar(cmd.duty1, cmd.duty2);
+        return;
+    }
+    if (cmd.tipo == CMD_ANALOGICO) {
+        DutyRuedas d = mezclarArcade(cmd.acelerador, cmd.giro, configMezcla);
+        ruedas.fijar(d.duty1, d.duty2);
+        return;
+    }
+    if (cmd.letra != '\0' && !esMovimiento(cmd)) REG_DEPURACION(REG_RX, parser.ultimaLinea());
+
+    switch (cmd.tipo) {
+        case CMD_VELOCIDAD:
+            if (cmd.objetivo == '1') {
+                motor1Speed = cmd.valor;
+                marcarCambioNvs(NVS_VELOCIDADES);
+                REG_INFO(REG_VEL_M1, motor1Speed);
+            } else if (cmd.objetivo == '2') {
+                motor2Speed = cmd.valor;
+                marcarCambioNvs(NVS_VELOCIDADES);
+                REG_INFO(REG_VEL_M2, motor2Speed);
+            } else {
+                generalSpeed = cmd.valor;
+                marcarCambioNvs(NVS_VELOCIDADES);
+                REG_INFO(REG_VEL_GENERAL, generalSpeed);
+                enviarUI(UI_VELOCIDAD_GENERAL, '\0', '\0', generalSpeed); // Solo mostrar actualización de velocidad
+            }
+            break;
+        case CMD_MOTOR: // F1, B1, S1, F2, B2, S2
+            if (cmd.objetivo == '1') { ruedas.motor1.fijar(velocidadConSigno(cmd.letra, motor1Speed)); }
+            else { ruedas.motor2.fijar(velocidadConSigno(cmd.letra, motor2Speed)); }
+            if (mostrar) mostrarMovimiento(cmd);
+            break;
+        case CMD_GENERAL: // U, D, L, R, S
+            moveMotorsGeneral(cmd.letra);
+            if (mostrar) mostrarMovimiento(cmd);
+            break;
+        case CMD_PRUEBA_PANTALLA:
+            enviarUI(UI_PRUEBA_PANTALLA);
+            break;
+        case CMD_METRICAS:
+            if (cmd.objetivo == 'B') borrarLatencias();
+            else reportarLatencias();
+            break;
+        case CMD_MACRO:
+            comandoMacro(cmd);
+            break;
+        case CMD_MANEJO:
+        case CMD_ANALOGICO:
+        case CMD_VIDA:
+            break;
+        case CMD_TRAMA:
+            procesarTrama(*cmd.trama);
+            break;
+        case CMD_ERROR:
+            comandosDescartados++;
+            switch (cmd.error) {
+                case ERR_FUERA_DE_RANGO: REG_AVISO(REG_VEL_FUERA_RANGO); break;
+                case ERR_C_INCOMPLETO: REG_AVISO(REG_C_INCOMPLETO); break;
+                case ERR_FBS_MALFORMADO: REG_AVISO(REG_FBS_MALFORMADO); break;
+                case ERR_TRAMA_CRC: REG_AVISO(REG_TRAMA_CORRUPTA); break;
+                case ERR_TRAMA_VIEJA: break; // Descartada en silencio
+                case ERR_TRAMA_TIPO: REG_AVISO(REG_TRAMA_MALFORMADA); break;
+                default: REG_AVISO(REG_DESCONOCIDO, parser.ultimaLinea()); break;
+            }
+            break;
+    }
+}
+
+// Ejecuta el comando midiendo su costo y el tiempo hasta que mueve un motor.
+// Un movimiento del piloto interrumpe la macro en curso y, si se está grabando, se graba.
+void atenderComando(const Comando& cmd, bool mostrar = true) {
+    bool movimiento = esMovimiento(cmd);
+    if (movimiento || cmd.tipo == CMD_VIDA) hal::alimentarVigilante();
+    if (movimiento && reproductorMacro.activo()) {
+        reproductorMacro.cancelar();
+        REG_INFO(REG_MACRO_INTERRUMPIDA);
+    }
+    SONDA_INICIO(tEjecucion);
+    ejecutarComando(cmd, mostrar);
+    SONDA_FIN(LAT_EJECUCION, tEjecucion);
+    if (movimiento) grabadorMacro.agregar(hal::millis(), ruedas.motor1.pedido(), ruedas.motor2.pedido());
+#if MEDIR_LATENCIA
+    if (ruedas.enRampa()) {
+        cicloComando = tEjecucion;
+        comandoPendientePwm = true;
+    }
+#endif
+}
+
+// Registra el peor periodo de la tarea de control y lo reporta cada loopReportInterval
+void medirPeriodoLoop() {
+    unsigned long ahora = hal::micros();
+    unsigned long periodo = ahora - lastLoopMicros;
+    lastLoopMicros = ahora;
+    if (periodo > maxLoopPeriod) maxLoopPeriod = periodo;
+    if (periodo > periodoMaxTelemetria) periodoMaxTelemetria = periodo;
+#if MEDIR_LATENCIA
+    const unsigned long nominal = 1000000UL / frecuenciaControl;
+    if (ahora != periodo) // La primera pasada no tiene periodo anterior
+        latencias[LAT_JITTER].registrar(periodo > nominal ? periodo - nominal : nominal - periodo);
+#endif
+
+    if (hal::millis() - lastLoopReport >= loopReportInterval) {
+        lastLoopReport = hal::millis();
+        REG_INFO(REG_PERIODO_MAX, maxLoopPeriod);
+        if (eventosUIPerdidos > 0) REG_INFO(REG_UI_PERDIDOS, eventosUIPerdidos);
+        if (comandosAgrupados > 0) REG_INFO(REG_AGRUPADOS, comandosAgrupados);
+        maxLoopPeriod = 0;
+    }
+}
+
+void pasoControl() {
+    medirPeriodoLoop();
+
+    if (enlace->connected()) {
         if (!connectedBefore) {
-            animacionInicio();
+            enviarUI(UI_CONECTADO);
             connectedBefore = true;
-            lastCommandTime = millis(); 
+            parser.reiniciar();
+            lastCommandTime = hal::millis(); 
         }
 
-        if (SerialBT.available()) {
-            String readData = SerialBT.readStringUntil('\n');
-            readData.trim();
-            lastCommandTime = millis(); 
-
-            if (readData.length() > 0) {
-                char firstChar = readData.charAt(0);
-                Serial.print("RX: "); Serial.println(readData);
-
-                if (firstChar == 'C') { 
-                    if (readData.length() >= 3) { 
-                        char target = readData.charAt(1); 
-                        // Asegurar que haya suficientes caracteres para el valor de velocidad
-                        // CGXXX (5 chars), C1XXX (5 chars)
-                        int required_len = (target == 'G' ? 5 : 5); 
-                        if (readData.length() >= required_len) {
-                           String speedStr = readData.substring(2, 5); // Siempre toma 3 dígitos para XXX
-                           int speedValue = speedStr.toInt();
-
-                            if (speedValue >= 0 && speedValue <= 255) {
-                                if (target == '1') {
-                                    motor1Speed = speedValue;
-                                    Serial.print("M1(Ind) Vel: "); Serial.println(motor1Speed);
-                                } else if (target == '2') {
-                                    motor2Speed = speedValue;
-                                    Serial.print("M2(Ind) Vel: "); Serial.println(motor2Speed);
-                                } else if (target == 'G') {
-                                    generalSpeed = speedValue;
-                                    Serial.print("Vel. General: "); Serial.println(generalSpeed);
-                                    display.clearDisplay(); display.setTextSize(1);
-                                    display.setCursor(5,20); display.print("Vel. General:");
-                                    display.setTextSize(2);
-                                    // Centrar el valor de la velocidad
-                                    int16_t x1, y1; uint16_t w, h;
-                                    String speedValStr = String(generalSpeed);
-                                    display.getTextBounds(speedValStr, 0, 0, &x1, &y1, &w, &h);
-                                    display.setCursor((SCREEN_WIDTH - w) / 2, 35);
-                                    display.print(speedValStr);
-                                    display.display();
-                                    // No redibujar flecha, solo mostrar actualización de velocidad
-                                }
-                            } else { Serial.println("Vel. fuera de rango (0-255)."); }
-                        } else { Serial.println("Comando C incompleto."); }
+        if (enlace->available()) {
+            // Consumir bytes sin bloquear: hasta completar un comando, o todo el buffer en modo agrupado.
+            // Al agrupar, cada comando se aplica en orden (los objetivos de motor se pisan entre sí
+            // y la rampa solo ve el último), pero solo el último movimiento se muestra.
+            Comando cmd;
+            Comando ultimoMovimiento;
+            uint16_t movimientos = 0;
+            for (uint16_t leidos = 0; leidos < bytesMaxPorPasada; leidos++) {
+                SONDA_INICIO(tRecepcion);
+                if (!enlace->available()) break;
+                uint8_t c = (uint8_t)enlace->read();
+                SONDA_FIN(LAT_RECEPCION, tRecepcion);
+                lastByteTime = hal::millis();
+                SONDA_INICIO(tParseo);
+                bool listo = parser.alimentar(c, cmd);
+                SONDA_FIN(LAT_PARSEO, tParseo);
+                if (listo) {
+                    lastCommandTime = lastByteTime;
+                    if (!agruparComandos) {
+                        atenderComando(cmd);
+                        break;
                     }
-                } else if (firstChar == 'F' || firstChar == 'B' || firstChar == 'S') { 
-                    if (readData.length() == 2) { // F1, B1, S1, F2, B2, S2
-                        char motorId = readData.charAt(1);
-                        if (motorId == '1') { controlMotor1(firstChar, motor1Speed); }
-                        else if (motorId == '2') { controlMotor2(firstChar, motor2Speed); }
-                        drawArrow(readData);
-                    } else if (firstChar == 'S' && readData.length() == 1) { // Comando 'S' general
-                        moveMotorsGeneral('S');
-                        drawArrow("S");
-                    } else { Serial.println("Comando F/B/S malformado."); }
-                } else if (firstChar == 'U' || firstChar == 'D' || firstChar == 'L' || firstChar == 'R' || firstChar == 'X') {
-                    if (firstChar == 'X') { drawArrow("X"); }
-                    else { moveMotorsGeneral(firstChar); drawArrow(String(firstChar)); }
-                } else { Serial.print("Comando Desconocido: "); Serial.println(readData); }
+                    bool movimiento = esMovimiento(cmd);
+                    atenderComando(cmd, !movimiento);
+                    if (movimiento) {
+                        ultimoMovimiento = cmd;
+                        movimientos++;
+                    }
+                }
             }
-        } else { // No hay datos BT disponibles, verificar timeout
-            if (millis() - lastCommandTime > commandTimeout) {
+            if (movimientos > 0) {
+                comandosAgrupados += movimientos - 1;
+                mostrarMovimiento(ultimoMovimiento);
+            }
+        } else { // No hay datos BT disponibles
+            // Línea sin '\n': cerrarla tras un tiempo sin datos
+            Comando cmd;
+            if (parser.pendiente() && hal::millis() - lastByteTime > lineTimeout) {
+                if (parser.finalizar(cmd)) {
+                    lastCommandTime = hal::millis();
+                    atenderComando(cmd);
+                }
+            }
+            // Verificar timeout
+            if (hal::millis() - lastCommandTime > commandTimeout) {
                 if (connectedBefore) { 
-                    Serial.println("Timeout BT -> STOP");
-                    moveMotorsGeneral('S');
-                    drawArrow("S"); 
-                    lastCommandTime = millis(); // Resetear para no enviar 'S' continuamente hasta nuevo comando
+                    REG_INFO(REG_TIMEOUT_BT);
+                    detenerMotores();
+                    enviarUI(UI_TIMEOUT);
+                    lastCommandTime = hal::millis(); // Resetear para no enviar 'S' continuamente hasta nuevo comando
                 }
             }
         }
 
-    } else { // Bluetooth no conectado
-        if (connectedBefore) {
-            display.clearDisplay(); display.setTextSize(1);
-            display.setCursor(15, 28); display.print("Desconectado!");
-            display.display(); delay(1000);
-            connectedBefore = false;
-            moveMotorsGeneral('S'); 
-        }
-        animacionEsperaBT();
-        delay(40); // Reducido para animación más fluida
+    } else if (connectedBefore) { // Bluetooth desconectado
+        connectedBefore = false;
+        detenerMotores();
+        enviarUI(UI_DESCONECTADO);
+    }
+}
+
+uint8_t dutyCanal(int16_t duty, bool atras) {
+    if (atras) return duty < 0 ? (uint8_t)(-duty) : 0;
+    return duty > 0 ? (uint8_t)duty : 0;
+}
+
+// Toma una muestra cada periodoTelemetria ms y encola el lote cuando se completa
+void pasoTelemetria() {
+    if (periodoTelemetria == 0 || !connectedBefore) {
+        muestrasEnLote = 0;
+        return;
+    }
+    unsigned long ahora = hal::millis();
+    if (ahora - ultimaMuestra < periodoTelemetria) return;
+    ultimaMuestra = ahora;
+
+    MuestraTelemetria m;
+    m.ms = ahora;
+    m.duty[0] = dutyCanal(ruedas.motor1.duty(), false);
+    m.duty[1] = dutyCanal(ruedas.motor1.duty(), true);
+    m.duty[2] = dutyCanal(ruedas.motor2.duty(), false);
+    m.duty[3] = dutyCanal(ruedas.motor2.duty(), true);
+    m.velocidad[0] = motor1Speed;
+    m.velocidad[1] = motor2Speed;
+    m.velocidad[2] = generalSpeed;
+    m.periodoMaxUs = (uint16_t)(periodoMaxTelemetria > 0xFFFF ? 0xFFFF : periodoMaxTelemetria);
+    m.colaRx = (uint16_t)enlace->available();
+    m.descartados = (uint16_t)comandosDescartados;
+    m.agrupados = (uint16_t)comandosAgrupados;
+    unsigned long desdeComando = ahora - lastCommandTime;
+    m.msDesdeComando = (uint16_t)(desdeComando > 0xFFFF ? 0xFFFF : desdeComando);
+    periodoMaxTelemetria = 0;
+
+    codificarTelemetria(seqTelemetria++, m, &loteTelemetria[muestrasEnLote * TRAMA_TELEMETRIA_BYTES]);
+    if (++muestrasEnLote >= muestrasPorLote) {
+        encolarEnvio(loteTelemetria, muestrasEnLote * TRAMA_TELEMETRIA_BYTES);
+        muestrasEnLote = 0;
     }
 }
+
+// La ISR del vigilante ya puso el PWM a 0; aquí se alinea el estado de los motores
+// para que la rampa no vuelva a escribir el duty anterior. Si ya estaban parados, el
+// PWM coincide con el duty guardado y un comando que llegó en este tick sigue valiendo.
+void revisarVigilante() {
+    if (!hal::vigilanteDisparado()) return;
+    if (ruedas.motor1.duty() == 0 && ruedas.motor2.duty() == 0) return;
+    REG_INFO(REG_VIGILANTE_STOP);
+    detenerMotores();
+    enviarUI(UI_TIMEOUT);
+}
+
+// Aplica las consignas de la macro que vencen en este tick. Mientras corre, la
+// macro hace de piloto: mantiene vivos el timeout de comandos y el vigilante.
+void pasoMacro() {
+    if (!reproductorMacro.activo()) return;
+    int16_t duty1, duty2;
+    if (reproductorMacro.paso(hal::millis(), duty1, duty2)) ruedas.fijar(duty1, duty2);
+    lastCommandTime = hal::millis();
+    hal::alimentarVigilante();
+}
+
+// Un tick de control (el simulador lo llama directamente)
+void pasoTareaControl() {
+    pasoControl();
+    revisarVigilante();
+    pasoMacro();
+    pasoTelemetria();
+    SONDA_INICIO(tActuacion);
+    actualizarMotores();
+    SONDA_FIN(LAT_ACTUACION, tActuacion);
+}
+
+void tareaControl(void*) {
+    hal::iniciarTick(frecuenciaControl);
+    for (;;) {
+        hal::esperarTick(10);
+        pasoTareaControl();
+    }
+}
+
+void loop() {
+    // Todo el trabajo ocurre en tareaControl y tareaUI
+    hal::terminarLoop();
+}
@@ -0,0 +1,82 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Decodificador de telemetría (PC)
+
+  Descripción:
+  Lee una captura de lo que el robot envió por Bluetooth (tramas
+  TRAMA_TELEMETRIA mezcladas con texto) y escribe una línea CSV por muestra.
+  Los bytes que no forman una trama válida se ignoran; al final informa las
+  tramas corruptas y las perdidas (saltos en la secuencia).
+  Si la secuencia o el reloj de las muestras vuelven atrás, el robot se
+  reinició (ambos empiezan en 0): sus muestras se escriben igual, la
+  secuencia se toma de nuevo desde esa trama y el resumen cuenta los
+  reinicios.
+
+  Uso:
+    g++ -std=c++17 -O2 -o DecodificarTelemetria DecodificarTelemetria.cpp
+    ./DecodificarTelemetria captura.bin [telemetria.csv]
+  Con '-' como captura lee de la entrada estándar; sin telemetria.csv
+  escribe en la salida estándar.
+  Para activar la telemetría enviar una TRAMA_TELEMETRIA_CONFIG
+  (ver ProtocoloBinario.h).
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "../Codigos/ProtocoloBinario.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s captura.bin|- [telemetria.csv]\n", argv[0]);
+        return 1;
+    }
+    FILE* entrada = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (!entrada) { perror(argv[1]); return 1; }
+    FILE* salida = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (!salida) { perror(argv[2]); return 1; }
+
+    fprintf(salida, "ms,m1_in1,m1_in2,m2_in1,m2_in2,motor1Speed,motor2Speed,generalSpeed,"
+                    "periodo_max_us,cola_rx,descartados,agrupados,ms_desde_comando\n");
+
+    DecodificadorTramas decodificador;
+    Trama trama = {};
+    MuestraTelemetria m;
+    unsigned long muestras = 0, corruptas = 0, perdidas = 0, reinicios = 0;
+    bool haySeq = false;
+    uint8_t seqEsperada = 0;
+    uint32_t msAnterior = 0;
+    int c;
+    while ((c = fgetc(entrada)) != EOF) {
+        if (!decodificador.enCurso() && c != TRAMA_SYNC) continue; // Texto u otros datos
+        ResultadoTrama r = decodificador.alimentar((uint8_t)c, trama);
+        if (r == TRAMA_ERROR_CRC) { corruptas++; continue; }
+        bool vieja = r == TRAMA_VIEJA; // En una captura no hay tramas repetidas
+        if (vieja) r = TRAMA_OK;
+        if (r != TRAMA_OK || !leerTelemetria(trama, m)) continue;
+
+        // Reinicio del robot: la secuencia o el reloj vuelven atrás. Sin reiniciar el
+        // decodificador, descartaría las tramas hasta pasar la secuencia anterior.
+        if (vieja || (haySeq && m.ms < msAnterior)) {
+            decodificador.reiniciar();
+            haySeq = false;
+            reinicios++;
+        }
+        msAnterior = m.ms;
+
+        if (haySeq && trama.seq != seqEsperada) perdidas += (uint8_t)(trama.seq - seqEsperada);
+        seqEsperada = (uint8_t)(trama.seq + 1);
+        haySeq = true;
+        muestras++;
+        fprintf(salida, "%lu,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", (unsigned long)m.ms, m.duty[0], m.duty[1],
+                m.duty[2], m.duty[3], m.velocidad[0], m.velocidad[1], m.velocidad[2], m.periodoMaxUs, m.colaRx,
+                m.descartados, m.agrupados, m.msDesdeComando);
+    }
+    if (entrada != stdin) fclose(entrada);
+    if (salida != stdout) fclose(salida);
+    fprintf(stderr, "%lu muestras, %lu tramas corruptas, %lu perdidas, %lu reinicios\n", muestras, corruptas, perdidas,
+            reinicios);
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Generador de carga (PC)
+
+  Descripción:
+  Compila principal.cpp contra la HAL de PC, como el simulador, pero le
+  entrega los comandos por un socket Unix (TransporteSocket sobre
+  socketpair()) a la tasa y en las ráfagas que se pidan, muy por encima de
+  lo que envía un teléfono. El reloj es simulado: un tick de control por ms.
+  Informa:
+  - Throughput: comandos enviados por segundo simulado, bytes que el robot
+    no alcanzó a leer y el costo real de CPU por tick y por comando.
+  - Errores de parseo: comandos descartados por el robot y los inyectados.
+  - Latencia comando -> actuación (p50/p90/p99/max), medida en las
+    escrituras PWM simuladas: desde el envío de un comando que cambia la
+    consigna con los motores quietos hasta la primera escritura PWM.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o GeneradorCarga GeneradorCarga.cpp ../Codigos/principal.cpp
+    ./GeneradorCarga [opciones]
+      -r <comandos/s>   Tasa media (por defecto 1000)
+      -b <n>            Comandos por ráfaga, enviados juntos (por defecto 1)
+      -t <ms>           Duración simulada (por defecto 5000)
+      -p <ms>           Cambio de consigna cada p ms (por defecto 250)
+      -m ascii|manejo   Flujo sintético: U/S/D o TRAMA_MANEJO (por defecto ascii)
+      -f <archivo>      Flujo grabado: un comando por línea o 'hex A5 01 ...';
+                        se repite en ciclo a la tasa pedida (ignora -m y -p)
+      -e <pct>          Porcentaje de comandos corrompidos (por defecto 0)
+      -v                Muestra el Serial del robot
+  El flujo sintético repite la consigna vigente (como un joystick) y la
+  cambia cada p ms: parada, adelante, parada, atrás... Con un flujo grabado
+  cuenta como cambio de consigna todo comando distinto del anterior.
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Hal.h"
+#include "Configuracion.h"
+#include "ProtocoloBinario.h"
+
+// principal.cpp
+void setup();
+void pasoTareaControl();
+void pasoTareaUI();
+void pasoTareaFondo();
+extern Transporte* enlace;
+extern uint32_t comandosDescartados;
+
+struct Opciones {
+    double tasa = 1000;
+    uint32_t rafaga = 1;
+    uint32_t duracionMs = 5000;
+    uint32_t periodoConsignaMs = 250;
+    bool manejo = false;
+    const char* archivo = NULL;
+    double corruptos = 0; // %
+};
+
+struct ComandoGenerado {
+    std::vector<uint8_t> bytes;
+    bool cambiaConsigna;
+};
+
+// Consignas del flujo sintético, en orden: parada, adelante, parada, atrás
+static ComandoGenerado comandoSintetico(const Opciones& o, uint32_t us, uint8_t& seq, int& consignaAnterior) {
+    static const char letras[4] = { 'S', 'U', 'S', 'D' };
+    static const int16_t duties[4] = { 0, 200, 0, -200 };
+    int consigna = (int)((us / 1000 / o.periodoConsignaMs) % 4);
+    ComandoGenerado c;
+    c.cambiaConsigna = consigna != consignaAnterior;
+    consignaAnterior = consigna;
+    if (o.manejo) {
+        uint8_t trama[TRAMA_LARGO_MAX];
+        size_t n = codificarManejo(seq++, duties[consigna], duties[consigna], trama);
+        c.bytes.assign(trama, trama + n);
+    } else {
+        c.bytes.push_back((uint8_t)letras[consigna]);
+        c.bytes.push_back('\n');
+    }
+    return c;
+}
+
+static bool leerGrabado(const char* ruta, std::vector<std::vector<uint8_t> >& comandos) {
+    FILE* f = fopen(ruta, "r");
+    if (!f) { perror(ruta); return false; }
+    char linea[256];
+    while (fgets(linea, sizeof(linea), f)) {
+        linea[strcspn(linea, "\r\n")] = '\0';
+        if (linea[0] == '\0' || linea[0] == '#') continue;
+        std::vector<uint8_t> bytes;
+        if (strncmp(linea, "hex ", 4) == 0) {
+            unsigned byte;
+            int n;
+            for (const char* p = linea + 4; sscanf(p, "%x%n", &byte, &n) == 1; p += n) bytes.push_back((uint8_t)byte);
+        } else {
+            bytes.assign(linea, linea + strlen(linea));
+            bytes.push_back('\n');
+        }
+        comandos.push_back(bytes);
+    }
+    fclose(f);
+    if (comandos.empty()) fprintf(stderr, "%s no tiene comandos\n", ruta);
+    return !comandos.empty();
+}
+
+// Un byte cambiado: en ASCII el primero (comando desconocido), en una trama el CRC
+static void corromper(std::vector<uint8_t>& bytes) {
+    if (bytes.empty()) return;
+    if (bytes[0] == TRAMA_SYNC) bytes.back() ^= 0xFF;
+    else bytes[0] = '#';
+}
+
+static uint64_t percentil(std::vector<uint64_t> v, unsigned p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[(v.size() - 1) * p / 100];
+}
+
+static void uso(const char* programa) {
+    fprintf(stderr, "Uso: %s [-r comandos/s] [-b rafaga] [-t ms] [-p ms] [-m ascii|manejo] [-f archivo] [-e pct] [-v]\n",
+            programa);
+}
+
+int main(int argc, char** argv) {
+    Opciones o;
+    Serial.activa = false;
+    for (int a = 1; a < argc; a++) {
+        bool hayValor = a + 1 < argc;
+        if (strcmp(argv[a], "-v") == 0) Serial.activa = true;
+        else if (hayValor && strcmp(argv[a], "-r") == 0) o.tasa = atof(argv[++a]);
+        else if (hayValor && strcmp(argv[a], "-b") == 0) o.rafaga = (uint32_t)atoi(argv[++a]);
+        else if (hayValor && strcmp(argv[a], "-t") == 0) o.duracionMs = (uint32_t)atoi(argv[++a]);
+        else if (hayValor && strcmp(argv[a], "-p") == 0) o.periodoConsignaMs = (uint32_t)atoi(argv[++a]);
+        else if (hayValor && strcmp(argv[a], "-m") == 0) o.manejo = strcmp(argv[++a], "manejo") == 0;
+        else if (hayValor && strcmp(argv[a], "-f") == 0) o.archivo = argv[++a];
+        else if (hayValor && strcmp(argv[a], "-e") == 0) o.corruptos = atof(argv[++a]);
+        else { uso(argv[0]); return 1; }
+    }
+    if (o.tasa <= 0 || o.rafaga == 0 || o.periodoConsignaMs == 0) { uso(argv[0]); return 1; }
+
+    std::vector<std::vector<uint8_t> > grabados;
+    if (o.archivo && !leerGrabado(o.archivo, grabados)) return 1;
+
+    int par[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, par) < 0) { perror("socketpair"); return 1; }
+    fcntl(par[0], F_SETFL, fcntl(par[0], F_GETFL, 0) | O_NONBLOCK);
+    static hal::TransporteSocket transporte;
+    transporte.adoptar(par[1]);
+    enlace = &transporte;
+    setup();
+
+    const double intervaloRafagaUs = 1e6 * o.rafaga / o.tasa;
+    const uint64_t finUs = (uint64_t)o.duracionMs * 1000;
+    uint64_t rafagas = 0;
+    uint8_t seq = 0;
+    int consignaAnterior = -1;
+    size_t indiceGrabado = 0;
+    std::vector<uint8_t> anteriorGrabado;
+    srand(1);
+
+    std::vector<uint8_t> pendiente;       // Bytes que el socket todavía no aceptó
+    std::vector<uint64_t> sondas;         // us de envío de los cambios de consigna con motores quietos
+    std::vector<uint64_t> latencias;
+    std::vector<uint64_t> tiemposPaso;    // ns reales por tick de control
+    uint64_t enviados = 0, corrompidos = 0, bytesEnviados = 0, bytesRespuesta = 0, ticksSocketLleno = 0;
+    size_t siguientePwm = 0;              // Primera escritura PWM aún no atribuida
+
+    for (uint64_t ms = 0; ms * 1000 <= finUs + 1000000; ms++) { // 1 s extra para vaciar
+        hal::relojUs = ms * 1000;
+
+        // Comandos de este ms: se envían al socket en el orden en que vencen
+        for (;;) {
+            uint64_t rafagaUs = (uint64_t)(rafagas * intervaloRafagaUs);
+            if (rafagaUs > hal::relojUs || rafagaUs >= finUs) break;
+            rafagas++;
+            for (uint32_t i = 0; i < o.rafaga; i++) {
+                ComandoGenerado c;
+                int consignaPrevia = consignaAnterior;
+                std::vector<uint8_t> grabadoPrevio = anteriorGrabado;
+                if (grabados.empty()) {
+                    c = comandoSintetico(o, (uint32_t)rafagaUs, seq, consignaAnterior);
+                } else {
+                    c.bytes = grabados[indiceGrabado++ % grabados.size()];
+                    c.cambiaConsigna = c.bytes != anteriorGrabado;
+                    anteriorGrabado = c.bytes;
+                }
+                if (o.corruptos > 0 && rand() % 10000 < (int)(o.corruptos * 100)) {
+                    // El robot lo descarta: la consigna sigue siendo la anterior
+                    corromper(c.bytes);
+                    c.cambiaConsigna = false;
+                    consignaAnterior = consignaPrevia;
+                    anteriorGrabado = grabadoPrevio;
+                    corrompidos++;
+                }
+                // Motores quietos: ninguna escritura PWM en los últimos 2 ms
+                bool quietos = hal::registroPwm.empty() || hal::registroPwm.back().us + 2000 < hal::relojUs;
+                if (c.cambiaConsigna && quietos) sondas.push_back(hal::relojUs);
+                pendiente.insert(pendiente.end(), c.bytes.begin(), c.bytes.end());
+                enviados++;
+            }
+        }
+        if (!pendiente.empty()) {
+            ssize_t n = send(par[0], pendiente.data(), pendiente.size(), MSG_NOSIGNAL);
+            if (n > 0) {
+                bytesEnviados += (uint64_t)n;
+                pendiente.erase(pendiente.begin(), pendiente.begin() + n);
+            }
+            if (!pendiente.empty()) ticksSocketLleno++;
+        }
+        uint8_t respuesta[4096];
+        ssize_t n;
+        while ((n = recv(par[0], respuesta, sizeof(respuesta), 0)) > 0) bytesRespuesta += (uint64_t)n;
+
+        hal::simularVigilante();
+        auto t0 = std::chrono::steady_clock::now();
+        pasoTareaControl();
+        auto t1 = std::chrono::steady_clock::now();
+        tiemposPaso.push_back((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        if (ms % periodoUI == 0) pasoTareaUI();
+        if (ms % periodoFondo == 0) pasoTareaFondo();
+    }
+
+    // Latencia de cada sonda: primera escritura PWM en o después de su envío
+    for (uint64_t t : sondas) {
+        while (siguientePwm < hal::registroPwm.size() && hal::registroPwm[siguientePwm].us < t) siguientePwm++;
+        if (siguientePwm < hal::registroPwm.size()) latencias.push_back(hal::registroPwm[siguientePwm].us - t);
+    }
+
+    uint64_t ticks = tiemposPaso.size();
+    uint64_t nsTotal = 0;
+    for (uint64_t ns : tiemposPaso) nsTotal += ns;
+    double segundos = o.duracionMs / 1000.0;
+    uint64_t sinLeer = (uint64_t)enlace->available() + pendiente.size();
+
+    printf("Carga: %.0f comandos/s en rafagas de %u durante %u ms (%s)\n", o.tasa, o.rafaga, o.duracionMs,
+           o.archivo ? o.archivo : (o.manejo ? "TRAMA_MANEJO" : "ASCII"));
+    printf("Enviados %llu comandos (%.0f/s), %llu bytes; sin leer al final %llu bytes; ticks con socket lleno %llu\n",
+           (unsigned long long)enviados, enviados / segundos, (unsigned long long)bytesEnviados,
+           (unsigned long long)sinLeer, (unsigned long long)ticksSocketLleno);
+    printf("Errores de parseo: %lu descartados por el robot (%llu corrompidos a proposito)\n",
+           (unsigned long)comandosDescartados, (unsigned long long)corrompidos);
+    printf("Latencia comando->actuacion (us simulados, %zu sondas): p50 %llu  p90 %llu  p99 %llu  max %llu\n",
+           latencias.size(), (unsigned long long)percentil(latencias, 50), (unsigned long long)percentil(latencias, 90),
+           (unsigned long long)percentil(latencias, 99), (unsigned long long)percentil(latencias, 100));
+    printf("Tiempo por tick de control (ns reales): p50 %llu  p99 %llu  max %llu; %.0f ns por comando\n",
+           (unsigned long long)percentil(tiemposPaso, 50), (unsigned long long)percentil(tiemposPaso, 99),
+           (unsigned long long)percentil(tiemposPaso, 100), enviados ? (double)nsTotal / enviados : 0.0);
+    printf("Respuestas del robot: %llu bytes; %llu ticks simulados\n", (unsigned long long)bytesRespuesta,
+           (unsigned long long)ticks);
+    close(par[0]);
+    return 0;
+}
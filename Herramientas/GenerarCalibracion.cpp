@@ -0,0 +1,119 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Generador de tablas de calibración (PC)
+
+  Descripción:
+  Convierte puntos medidos (duty -> velocidad) de cada motor y sentido en las
+  tablas de Calibracion.h, y las empaqueta como tramas binarias listas para
+  enviar al robot por Bluetooth (ver ProtocoloBinario.h).
+
+  Uso:
+    g++ -std=c++17 -O2 -o GenerarCalibracion GenerarCalibracion.cpp
+    ./GenerarCalibracion medidas.txt calibracion.bin [seq_inicial]
+
+  Formato de medidas.txt, una medida por línea ('#' inicia un comentario):
+    <motor 1|2> <sentido F|B> <duty 0-255> <velocidad>
+  Ejemplo:
+    1 F 0 0
+    1 F 60 0      # zona muerta: no gira con duty 60
+    1 F 80 35
+    1 F 255 410
+
+  calibracion.bin contiene las tramas de las 4 tablas y una trama final con
+  CAL_GUARDAR. Enviarlo recién conectado (la secuencia empieza en
+  seq_inicial, por defecto 1). Las tablas sin medidas quedan lineales.
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "../Codigos/Calibracion.h"
+#include "../Codigos/ProtocoloBinario.h"
+
+static bool compararDuty(const PuntoCalibracion& a, const PuntoCalibracion& b) {
+    return a.duty < b.duty;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Uso: %s medidas.txt calibracion.bin [seq_inicial]\n", argv[0]);
+        return 1;
+    }
+    FILE* entrada = fopen(argv[1], "r");
+    if (!entrada) { perror(argv[1]); return 1; }
+    uint8_t seq = (uint8_t)(argc > 3 ? atoi(argv[3]) : 1);
+
+    std::vector<PuntoCalibracion> puntos[CAL_TABLAS];
+    char linea[128];
+    int numeroLinea = 0;
+    while (fgets(linea, sizeof(linea), entrada)) {
+        numeroLinea++;
+        char* comentario = strchr(linea, '#');
+        if (comentario) *comentario = '\0';
+        int motor, duty;
+        unsigned velocidad;
+        char sentido;
+        int leidos = sscanf(linea, "%d %c %d %u", &motor, &sentido, &duty, &velocidad);
+        if (leidos <= 0) continue;
+        if (leidos != 4 || (motor != 1 && motor != 2) || (sentido != 'F' && sentido != 'B') ||
+            duty < 0 || duty > 255 || velocidad > 65535) {
+            fprintf(stderr, "Linea %d invalida\n", numeroLinea);
+            return 1;
+        }
+        PuntoCalibracion p = { (uint8_t)duty, (uint16_t)velocidad };
+        puntos[indiceTabla((uint8_t)(motor - 1), sentido == 'F' ? 0 : 1)].push_back(p);
+    }
+    fclose(entrada);
+
+    // Velocidad tope común: la menor de las máximas, para que todos los motores la alcancen
+    uint16_t velocidadMax = 0xFFFF;
+    for (uint8_t t = 0; t < CAL_TABLAS; t++) {
+        if (puntos[t].empty()) continue;
+        std::stable_sort(puntos[t].begin(), puntos[t].end(), compararDuty);
+        uint16_t maxima = 0;
+        for (size_t i = 0; i < puntos[t].size(); i++) {
+            // Se fuerza velocidad no decreciente (ruido de medición)
+            if (i > 0 && puntos[t][i].velocidad < puntos[t][i - 1].velocidad) {
+                puntos[t][i].velocidad = puntos[t][i - 1].velocidad;
+            }
+            if (puntos[t][i].velocidad > maxima) maxima = puntos[t][i].velocidad;
+        }
+        if (maxima < velocidadMax) velocidadMax = maxima;
+    }
+    if (velocidadMax == 0xFFFF || velocidadMax == 0) {
+        fprintf(stderr, "No hay medidas con velocidad > 0\n");
+        return 1;
+    }
+
+    TablasCalibracion tablas;
+    for (uint8_t t = 0; t < CAL_TABLAS; t++) {
+        if (puntos[t].empty()) tablaCompensacion(tablas.tabla[t], 0);
+        else generarTablaCalibracion(puntos[t].data(), (uint8_t)std::min<size_t>(puntos[t].size(), 255), velocidadMax, tablas.tabla[t]);
+        printf("Motor %d %s: 1->%u 64->%u 128->%u 192->%u 255->%u%s\n", t / CAL_SENTIDOS + 1,
+               t % CAL_SENTIDOS == 0 ? "adelante" : "atras", tablas.tabla[t][1], tablas.tabla[t][64],
+               tablas.tabla[t][128], tablas.tabla[t][192], tablas.tabla[t][255], puntos[t].empty() ? " (lineal)" : "");
+    }
+    printf("Velocidad tope comun: %u\n", velocidadMax);
+
+    FILE* salida = fopen(argv[2], "wb");
+    if (!salida) { perror(argv[2]); return 1; }
+    uint8_t trama[TRAMA_LARGO_MAX];
+    size_t tramas = 0;
+    for (uint8_t t = 0; t < CAL_TABLAS; t++) {
+        for (uint16_t posicion = 0; posicion < 256; posicion += TRAMA_CALIBRACION_VALORES_MAX) {
+            uint8_t cantidad = (uint8_t)std::min<uint16_t>(TRAMA_CALIBRACION_VALORES_MAX, 256 - posicion);
+            size_t n = codificarCalibracion(seq++, t, (uint8_t)posicion, &tablas.tabla[t][posicion], cantidad, trama);
+            fwrite(trama, 1, n, salida);
+            tramas++;
+        }
+    }
+    fwrite(trama, 1, codificarCalibracionFin(seq++, CAL_GUARDAR, trama), salida);
+    fclose(salida);
+    printf("%zu tramas escritas en %s\n", tramas + 1, argv[2]);
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Medición de bytes enviados a la OLED (PC)
+
+  Descripción:
+  Compila principal.cpp contra la HAL de PC y recorre, con reloj simulado,
+  todas las pantallas actuales del firmware: la espera de Bluetooth, la
+  animación de conexión, las flechas U/D/L/R, STOP, los textos de F/B/S
+  1/2, la velocidad general (CG), la prueba de pantalla (X) y la de
+  desconexión. Por cada una informa los display(), los bytes de datos que
+  el envío diferencial manda por I2C (FramebufferSombra.h) y los que
+  mandaría el envío completo (1024 por display()).
+  El texto se dibuja con glifos de relleno de 6x8 (HalHost.h): las columnas
+  que cambian son las mismas que con la fuente real, no los bits.
+  Termina con código 1 si redibujar la misma pantalla envía algún byte o si
+  se envía más que la pantalla completa.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o MedicionPantalla MedicionPantalla.cpp ../Codigos/principal.cpp
+    ./MedicionPantalla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include "../Pruebas/ArnesPruebas.h"
+
+// principal.cpp
+extern hal::Pantalla<128, 64> display;
+
+const uint32_t BYTES_PANTALLA = 128 * 64 / 8;
+
+struct Medida {
+    uint32_t envios = 0;
+    uint64_t bytes = 0;
+    uint32_t maxEnvio = 0;
+};
+
+static Medida actual;
+static uint64_t totalDiferencial = 0, totalCompleto = 0;
+
+// Un tick del arnés (con el comando 'texto', si hay), sumando lo que la tarea de pantalla envió a la OLED
+static void tickMedido(const char* texto = NULL) {
+    uint32_t envios = display.envios;
+    uint64_t bytes = display.bytesEnviados;
+    if (texto) tickComando(texto);
+    else tick();
+    actual.envios += display.envios - envios;
+    actual.bytes += display.bytesEnviados - bytes;
+    // Con un solo display() en el tick se conoce su tamaño (al iniciar la pantalla hay dos)
+    if (display.envios == envios + 1 && display.bytesUltimoEnvio > actual.maxEnvio) {
+        actual.maxEnvio = display.bytesUltimoEnvio;
+    }
+}
+
+static void avanzarMedido(uint32_t duracion) {
+    uint32_t fin = ms + duracion;
+    while (ms < fin) tickMedido();
+}
+
+static void informar(const char* nombre, bool debeSerCero = false) {
+    uint64_t completo = (uint64_t)actual.envios * BYTES_PANTALLA;
+    double ahorro = completo > 0 ? 100.0 * (1.0 - (double)actual.bytes / completo) : 0;
+    printf("%-28s %8lu %10llu %10llu %8.1f%% %9lu\n", nombre, (unsigned long)actual.envios,
+           (unsigned long long)actual.bytes, (unsigned long long)completo, ahorro, (unsigned long)actual.maxEnvio);
+    if (actual.maxEnvio > BYTES_PANTALLA || actual.bytes > completo) {
+        printf("FALLA %s: se enviaron mas bytes que la pantalla completa\n", nombre);
+        fallas++;
+    }
+    if (debeSerCero && actual.bytes != 0) {
+        printf("FALLA %s: redibujar la misma pantalla envio %llu bytes\n", nombre, (unsigned long long)actual.bytes);
+        fallas++;
+    }
+    totalDiferencial += actual.bytes;
+    totalCompleto += completo;
+    actual = Medida();
+}
+
+// Comando y 200 ms para que la tarea de pantalla lo dibuje
+static void pantalla(const char* texto, const char* nombre, bool debeSerCero = false) {
+    tickMedido(texto);
+    avanzarMedido(199);
+    informar(nombre, debeSerCero);
+}
+
+int main() {
+    printf("%-28s %8s %10s %10s %9s %9s\n", "Pantalla", "display", "bytes", "completo", "ahorro", "max/envio");
+
+    iniciarFirmware();
+    avanzarMedido(1200); // Primer envío (completo) y 30 cuadros del círculo girando
+    informar("Esperando BT (1,2 s)");
+
+    SerialBT.conectar(true);
+    avanzarMedido(1500);
+    informar("Conectado! / barra / LISTO!");
+
+    pantalla("U", "Flecha U");
+    pantalla("U", "Flecha U repetida", true);
+    pantalla("D", "Flecha D");
+    pantalla("L", "Flecha L");
+    pantalla("R", "Flecha R");
+    pantalla("S", "STOP");
+    pantalla("F1", "Motor DER: Adelante");
+    pantalla("B1", "Motor DER: Atras");
+    pantalla("S1", "Motor DER: STOP");
+    pantalla("F2", "Motor IZQ: Adelante");
+    pantalla("B2", "Motor IZQ: Atras");
+    pantalla("S2", "Motor IZQ: STOP");
+    pantalla("CG128", "Vel. General 128");
+    pantalla("CG129", "Vel. General 129 (1 digito)");
+    pantalla("CG129", "Vel. General 129 repetida", true);
+    pantalla("CG200", "Vel. General 200");
+    tickMedido("X");
+    avanzarMedido(2500);
+    informar("Prueba de pantalla (X)");
+
+    SerialBT.conectar(false);
+    avanzarMedido(1000);
+    informar("Desconectado!");
+    avanzarMedido(1200);
+    informar("Esperando BT de nuevo (1,2 s)");
+
+    printf("Total: %llu bytes con envio diferencial, %llu con envio completo (%.1f%% menos)\n",
+           (unsigned long long)totalDiferencial, (unsigned long long)totalCompleto,
+           totalCompleto > 0 ? 100.0 * (1.0 - (double)totalDiferencial / totalCompleto) : 0);
+    return terminarPrueba();
+}
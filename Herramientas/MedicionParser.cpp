@@ -0,0 +1,238 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Medición del parser de comandos (PC)
+
+  Descripción:
+  Alimenta ParserComandos (Codigos/ParserComandos.h) con un flujo que
+  contiene todos los comandos: C1/C2/CG XXX, F/B/S 1/2, U/D/L/R/S, X, M/MB,
+  G/GS/P, BYTE_VIDA, tramas TRAMA_MANEJO y TRAMA_ANALOGICO, y líneas
+  malformadas y una trama corrupta. Informa:
+  - Throughput: MB/s, millones de comandos/s y ns por byte.
+  - Latencia por comando, desde su primer byte hasta que alimentar()
+    devuelve true (p50/p99/p99.9/max, ya restado el costo del reloj), por
+    tipo de comando y en total.
+  Antes de medir comprueba que cada comando salga con su tipo, objetivo,
+  valor y error esperados, y durante la medición que el parser no pida
+  memoria dinámica (operator new contado). Si algo de eso falla termina
+  con código 1; los tiempos solo se informan. En el PC el máximo incluye
+  interrupciones del sistema operativo: la cota útil es p99.9.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o MedicionParser MedicionParser.cpp
+    ./MedicionParser [vueltas]        Por defecto 20000 vueltas del flujo
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <vector>
+#include "ParserComandos.h"
+
+// Cuenta los pedidos de memoria mientras 'contarMemoria' está activo
+static bool contarMemoria = false;
+static unsigned long pedidosMemoria = 0;
+
+// noinline: si GCC ve el free() dentro de un destructor avisa de new/free mezclados
+__attribute__((noinline)) void* operator new(size_t n) {
+    if (contarMemoria) pedidosMemoria++;
+    void* p = malloc(n ? n : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t n) { return operator new(n); }
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+typedef std::chrono::steady_clock Reloj;
+
+struct Esperado {
+    TipoComando tipo;
+    ErrorComando error;
+    char letra;
+    char objetivo;
+    uint8_t valor;
+};
+
+struct Flujo {
+    std::vector<uint8_t> bytes;
+    std::vector<size_t> fin;         // Índice del byte que completa cada comando
+    std::vector<Esperado> esperados;
+    std::vector<uint8_t> grupo;      // Índice en 'nombresGrupo'
+};
+
+static const char* const nombresGrupo[] = { "C1/C2/CG XXX", "F/B/S 1/2", "U/D/L/R/S/X", "M/G/P", "BYTE_VIDA",
+                                            "tramas", "malformados" };
+const uint8_t GRUPOS = sizeof(nombresGrupo) / sizeof(nombresGrupo[0]);
+
+static void agregar(Flujo& f, const uint8_t* datos, size_t largo, uint8_t grupo, Esperado e) {
+    f.bytes.insert(f.bytes.end(), datos, datos + largo);
+    f.fin.push_back(f.bytes.size() - 1);
+    f.esperados.push_back(e);
+    f.grupo.push_back(grupo);
+}
+
+static void agregarLinea(Flujo& f, const char* linea, uint8_t grupo, Esperado e) {
+    agregar(f, (const uint8_t*)linea, strlen(linea), grupo, e);
+}
+
+// Una vuelta del flujo; 'seq' sigue creciendo entre vueltas
+static void agregarVuelta(Flujo& f, uint8_t& seq) {
+    const Esperado ok = { CMD_GENERAL, ERR_NINGUNO, 0, '\0', 0 };
+    Esperado e;
+
+    e = ok; e.tipo = CMD_VELOCIDAD; e.letra = 'C';
+    e.objetivo = '1'; e.valor = 128; agregarLinea(f, "C1128\n", 0, e);
+    e.objetivo = '2'; e.valor = 255; agregarLinea(f, "C2255\r\n", 0, e);
+    e.objetivo = 'G'; e.valor = 0;   agregarLinea(f, "CG000\n", 0, e);
+
+    const char* motores[] = { "F1\n", "B1\n", "S1\n", "F2\n", "B2\n", "S2\n" };
+    for (const char* m : motores) {
+        e = ok; e.tipo = CMD_MOTOR; e.letra = m[0]; e.objetivo = m[1];
+        agregarLinea(f, m, 1, e);
+    }
+
+    const char* generales[] = { "U\n", "D\n", "L\n", "R\n", "S\n", "X\n" };
+    for (const char* g : generales) {
+        e = ok; e.letra = g[0];
+        if (g[0] == 'X') e.tipo = CMD_PRUEBA_PANTALLA;
+        agregarLinea(f, g, 2, e);
+    }
+
+    const char* otros[] = { "M\n", "MB\n", "G3\n", "GS\n", "P3\n" };
+    for (const char* o : otros) {
+        e = ok; e.tipo = o[0] == 'M' ? CMD_METRICAS : CMD_MACRO; e.letra = o[0];
+        e.objetivo = o[1] == '\n' ? '\0' : o[1];
+        agregarLinea(f, o, 3, e);
+    }
+
+    e = ok; e.tipo = CMD_VIDA; e.letra = '\0';
+    agregar(f, &BYTE_VIDA, 1, 4, e);
+
+    uint8_t trama[TRAMA_LARGO_MAX];
+    size_t largo = codificarManejo(seq++, 120, -120, trama);
+    e = ok; e.tipo = CMD_MANEJO; e.letra = '\0';
+    agregar(f, trama, largo, 5, e);
+    largo = codificarAnalogico(seq++, 100, -50, trama);
+    e.tipo = CMD_ANALOGICO;
+    agregar(f, trama, largo, 5, e);
+
+    e = ok; e.tipo = CMD_ERROR; e.letra = 'C';
+    e.error = ERR_FUERA_DE_RANGO; e.objetivo = '1'; agregarLinea(f, "C1300\n", 6, e);
+    e.error = ERR_C_INCOMPLETO;                     agregarLinea(f, "C1\n", 6, e);
+    e.error = ERR_FBS_MALFORMADO; e.letra = 'F'; e.objetivo = '3'; agregarLinea(f, "F3\n", 6, e);
+    e.error = ERR_DESCONOCIDO; e.letra = 'Z'; e.objetivo = '\0';   agregarLinea(f, "Z\n", 6, e);
+    largo = codificarManejo(seq, 10, 10, trama); // Misma seq: la trama corrupta no la consume
+    trama[TRAMA_CABECERA] ^= 0x40;
+    e.error = ERR_TRAMA_CRC; e.letra = '\0';
+    agregar(f, trama, largo, 6, e);
+}
+
+static bool verificarFlujo(const Flujo& f) {
+    ParserComandos parser;
+    Comando cmd = {};
+    size_t k = 0, malos = 0;
+    for (size_t i = 0; i < f.bytes.size(); i++) {
+        if (!parser.alimentar(f.bytes[i], cmd)) continue;
+        if (k >= f.esperados.size() || f.fin[k] != i) { malos++; k++; continue; }
+        const Esperado& e = f.esperados[k];
+        bool bien = cmd.tipo == e.tipo && cmd.error == e.error;
+        if (e.letra != '\0') bien = bien && cmd.letra == e.letra && cmd.objetivo == e.objetivo;
+        if (e.tipo == CMD_VELOCIDAD) bien = bien && cmd.valor == e.valor;
+        if (e.tipo == CMD_MANEJO) bien = bien && cmd.duty1 == 120 && cmd.duty2 == -120;
+        if (e.tipo == CMD_ANALOGICO) bien = bien && cmd.acelerador == 100 && cmd.giro == -50;
+        if (!bien && malos == 0) printf("FALLA comando %zu (grupo %s) no es el esperado\n", k, nombresGrupo[f.grupo[k]]);
+        if (!bien) malos++;
+        k++;
+    }
+    if (k != f.esperados.size()) printf("FALLA %zu comandos de %zu esperados\n", k, f.esperados.size());
+    return malos == 0 && k == f.esperados.size() && !parser.pendiente();
+}
+
+static double nsEntre(Reloj::time_point a, Reloj::time_point b) {
+    return std::chrono::duration<double, std::nano>(b - a).count();
+}
+
+static void informarLatencias(const char* nombre, std::vector<float>& v) {
+    if (v.empty()) return;
+    std::sort(v.begin(), v.end());
+    auto p = [&](double q) { return v[std::min(v.size() - 1, (size_t)(q * v.size()))]; };
+    printf("  %-14s %9zu  p50 %6.1f  p99 %6.1f  p99.9 %7.1f  max %8.1f ns\n", nombre, v.size(), p(0.5), p(0.99),
+           p(0.999), v.back());
+}
+
+int main(int argc, char** argv) {
+    uint32_t vueltas = argc > 1 ? (uint32_t)atoi(argv[1]) : 20000;
+    if (vueltas == 0) vueltas = 1;
+
+    // 128 vueltas base: 256 tramas, así la seq sigue creciendo al repetir el flujo
+    Flujo f;
+    uint8_t seq = 0;
+    for (int i = 0; i < 128; i++) agregarVuelta(f, seq);
+    uint32_t repeticiones = (vueltas + 127) / 128;
+
+    bool correcto = verificarFlujo(f);
+    printf("%s %zu comandos en %zu bytes con el tipo, objetivo, valor y error esperados\n",
+           correcto ? "ok   " : "FALLA", f.esperados.size(), f.bytes.size());
+
+    // Throughput: todo el flujo de corrido
+    ParserComandos parser;
+    Comando cmd = {};
+    size_t completos = 0;
+    contarMemoria = true;
+    Reloj::time_point inicio = Reloj::now();
+    for (uint32_t r = 0; r < repeticiones; r++) {
+        const uint8_t* p = f.bytes.data();
+        for (size_t i = 0, n = f.bytes.size(); i < n; i++) completos += parser.alimentar(p[i], cmd) ? 1 : 0;
+    }
+    double ns = nsEntre(inicio, Reloj::now());
+    contarMemoria = false;
+    double bytes = (double)f.bytes.size() * repeticiones;
+    bool todos = completos == f.esperados.size() * repeticiones;
+    printf("Throughput: %.1f MB/s, %.2f M comandos/s, %.2f ns/byte (%.0f bytes, %zu comandos)\n",
+           bytes / ns * 1e3, completos / ns * 1e3, ns / bytes, bytes, completos);
+
+    // Costo de leer el reloj, para restarlo de cada medición
+    std::vector<float> vacio(100000);
+    for (float& v : vacio) {
+        Reloj::time_point a = Reloj::now();
+        v = (float)nsEntre(a, Reloj::now());
+    }
+    std::sort(vacio.begin(), vacio.end());
+    float costoReloj = vacio[vacio.size() / 2];
+
+    // Latencia por comando
+    std::vector<float> porGrupo[GRUPOS], total;
+    total.reserve(f.esperados.size() * repeticiones);
+    for (std::vector<float>& v : porGrupo) v.reserve(total.capacity() / 4);
+    contarMemoria = true;
+    unsigned long pedidosAntes = pedidosMemoria;
+    for (uint32_t r = 0; r < repeticiones; r++) {
+        size_t i = 0;
+        for (size_t k = 0; k < f.fin.size(); k++) {
+            Reloj::time_point a = Reloj::now();
+            for (; i <= f.fin[k]; i++) parser.alimentar(f.bytes[i], cmd);
+            float t = std::max(0.0f, (float)nsEntre(a, Reloj::now()) - costoReloj);
+            std::vector<float>& g = porGrupo[f.grupo[k]];
+            if (g.size() < g.capacity()) g.push_back(t); // Sin crecer: no cuenta como memoria del parser
+            if (total.size() < total.capacity()) total.push_back(t);
+        }
+    }
+    contarMemoria = false;
+    bool sinMemoria = pedidosMemoria == pedidosAntes && pedidosMemoria == 0;
+
+    printf("Latencia por comando, primer byte -> completo (reloj %.1f ns restado):\n", costoReloj);
+    for (uint8_t g = 0; g < GRUPOS; g++) informarLatencias(nombresGrupo[g], porGrupo[g]);
+    informarLatencias("total", total);
+
+    printf("%s todas las vueltas entregan todos los comandos\n", todos ? "ok   " : "FALLA");
+    printf("%s sin memoria dinamica al parsear (%lu pedidos)\n", sinMemoria ? "ok   " : "FALLA", pedidosMemoria);
+    return correcto && todos && sinMemoria ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Medición del costo de dibujo por cuadro (PC)
+
+  Descripción:
+  Compara, cuadro por cuadro, el dibujo de antes y el de ahora en el mismo
+  framebuffer de 128x64 con formato SSD1306:
+  - Antes: fillTriangle + fillRect para las flechas y cos/sin en coma
+    flotante + fillCircle para los círculos de las animaciones, con los
+    algoritmos de Adafruit_GFX / Adafruit_SSD1306 (líneas verticales por
+    bytes, horizontales por píxel).
+  - Ahora: copia de los sprites y tablas de Sprites.h, con la misma
+    geometría que principal.cpp.
+  Informa ns por cuadro (borrar + dibujar, sin el texto, que no cambió) y
+  la relación antes/ahora para las flechas U/D/L/R y los cuadros de las
+  animaciones de espera y de conexión. En el ESP32 la relación es mayor:
+  cos/sin en double no tienen FPU.
+  Comprueba además que cada sprite tenga exactamente los mismos píxeles que
+  el dibujo de antes en la misma posición; si alguno difiere termina con
+  código 1.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o MedicionRender MedicionRender.cpp
+    ./MedicionRender [repeticiones]   Por defecto 200000 cuadros por caso
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "Sprites.h"
+
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+#define CX (SCREEN_WIDTH / 2)
+#define CY (SCREEN_HEIGHT / 2)
+
+static uint8_t fb[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+
+// ---------------------------------------------------------------------------
+// Antes: primitivas como Adafruit_GFX / Adafruit_SSD1306
+// ---------------------------------------------------------------------------
+
+static void pixel(int16_t x, int16_t y) {
+    if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) return;
+    fb[(y / 8) * SCREEN_WIDTH + x] |= (uint8_t)(1 << (y & 7));
+}
+
+static void lineaH(int16_t x, int16_t y, int16_t w) {
+    for (int16_t i = x; i < x + w; i++) pixel(i, y);
+}
+
+// Por bytes: la parte de la primera página, las páginas completas y la última
+static void lineaV(int16_t x, int16_t y, int16_t h) {
+    if (x < 0 || x >= SCREEN_WIDTH) return;
+    if (y < 0) { h += y; y = 0; }
+    if (y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
+    if (h <= 0) return;
+    uint8_t* p = &fb[(y / 8) * SCREEN_WIDTH + x];
+    uint8_t mod = (uint8_t)(y & 7);
+    if (mod) {
+        mod = (uint8_t)(8 - mod);
+        uint8_t mascara = (uint8_t)(0xFF << (8 - mod));
+        if (h < mod) mascara &= (uint8_t)(0xFF >> (mod - h));
+        *p |= mascara;
+        p += SCREEN_WIDTH;
+        h -= mod;
+    }
+    for (; h >= 8; h -= 8, p += SCREEN_WIDTH) *p = 0xFF;
+    if (h > 0) *p |= (uint8_t)((1 << h) - 1);
+}
+
+static void rectanguloRelleno(int16_t x, int16_t y, int16_t w, int16_t h) {
+    for (int16_t i = x; i < x + w; i++) lineaV(i, y, h);
+}
+
+template <typename T>
+static void intercambiar(T& a, T& b) { T t = a; a = b; b = t; }
+
+static void trianguloRelleno(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    if (y0 > y1) { intercambiar(y0, y1); intercambiar(x0, x1); }
+    if (y1 > y2) { intercambiar(y2, y1); intercambiar(x2, x1); }
+    if (y0 > y1) { intercambiar(y0, y1); intercambiar(x0, x1); }
+    int16_t a, b, y, ultima;
+    if (y0 == y2) {
+        a = b = x0;
+        if (x1 < a) a = x1; else if (x1 > b) b = x1;
+        if (x2 < a) a = x2; else if (x2 > b) b = x2;
+        lineaH(a, y0, b - a + 1);
+        return;
+    }
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    ultima = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0; y <= ultima; y++) {
+        a = x0 + sa / dy01;
+        b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b) intercambiar(a, b);
+        lineaH(a, y, b - a + 1);
+    }
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        a = x1 + sa / dy12;
+        b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b) intercambiar(a, b);
+        lineaH(a, y, b - a + 1);
+    }
+}
+
+static void circuloRelleno(int16_t x0, int16_t y0, int16_t r) {
+    lineaV(x0, y0 - r, 2 * r + 1);
+    int16_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r, px = x, py = y;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddy += 2;
+            f += ddy;
+        }
+        x++;
+        ddx += 2;
+        f += ddx;
+        if (x < y + 1) {
+            lineaV(x0 + x, y0 - y, 2 * y + 1);
+            lineaV(x0 - x, y0 - y, 2 * y + 1);
+        }
+        if (y != py) {
+            lineaV(x0 + py, y0 - px, 2 * px + 1);
+            lineaV(x0 - py, y0 - px, 2 * px + 1);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+// Los cuadros de antes, como estaban en principal.cpp
+static void antesFlecha(char direccion) {
+    switch (direccion) {
+        case 'D':
+            trianguloRelleno(CX, CY - 15, CX - 10, CY, CX + 10, CY);
+            rectanguloRelleno(CX - 4, CY, 8, 15);
+            break;
+        case 'U':
+            trianguloRelleno(CX, CY + 15, CX - 10, CY, CX + 10, CY);
+            rectanguloRelleno(CX - 4, CY - 15, 8, 15);
+            break;
+        case 'R':
+            trianguloRelleno(CX - 15, CY, CX, CY - 10, CX, CY + 10);
+            rectanguloRelleno(CX, CY - 4, 15, 8);
+            break;
+        default:
+            trianguloRelleno(CX + 15, CY, CX, CY - 10, CX, CY + 10);
+            rectanguloRelleno(CX - 15, CY - 4, 15, 8);
+            break;
+    }
+}
+
+static void antesEspera(uint16_t cuadro) {
+    int angulo = (cuadro % 30) * 12;
+    float anguloRad = angulo * M_PI / 180.0;
+    int x = SCREEN_WIDTH / 2 + cos(anguloRad) * (SCREEN_HEIGHT / 2 - 12);
+    int y = SCREEN_HEIGHT / 2 + sin(anguloRad) * (SCREEN_HEIGHT / 2 - 12);
+    circuloRelleno(x, y, 5);
+}
+
+static void antesInicio(uint16_t cuadro) {
+    float anguloRad = (cuadro % 15 * 25) * M_PI / 180.0;
+    int x = SCREEN_WIDTH / 2 + cos(anguloRad) * 20;
+    int y = SCREEN_HEIGHT / 2 + sin(anguloRad) * 20;
+    circuloRelleno(x, y, 3);
+}
+
+// ---------------------------------------------------------------------------
+// Ahora: la geometría de principal.cpp
+// ---------------------------------------------------------------------------
+
+constexpr TablaGiro<30> giroEspera = calcularGiro<30>(CX, CY, SCREEN_HEIGHT / 2 - 12, 12);
+constexpr TablaGiro<15> giroInicio = calcularGiro<15>(CX, CY, 20, 25);
+constexpr Sprite<11, 11> circuloEspera = rasterizar<11, 11>(Circulo{0, 0, 5}, -5, -5);
+constexpr Sprite<7, 7> circuloInicio = rasterizar<7, 7>(Circulo{0, 0, 3}, -3, -3);
+constexpr Sprite<31, 31> flechaArriba = rasterizar<31, 31>(
+    Flecha{{CX, CY - 15, CX - 10, CY, CX + 10, CY}, {CX - 4, CY, 8, 15}}, CX - 15, CY - 15);
+constexpr Sprite<31, 31> flechaAbajo = rasterizar<31, 31>(
+    Flecha{{CX, CY + 15, CX - 10, CY, CX + 10, CY}, {CX - 4, CY - 15, 8, 15}}, CX - 15, CY - 15);
+constexpr Sprite<31, 31> flechaIzquierda = rasterizar<31, 31>(
+    Flecha{{CX - 15, CY, CX, CY - 10, CX, CY + 10}, {CX, CY - 4, 15, 8}}, CX - 15, CY - 15);
+constexpr Sprite<31, 31> flechaDerecha = rasterizar<31, 31>(
+    Flecha{{CX + 15, CY, CX, CY - 10, CX, CY + 10}, {CX - 15, CY - 4, 15, 8}}, CX - 15, CY - 15);
+
+template <uint8_t W, uint8_t H>
+static void dibujar(const Sprite<W, H>& sprite, int16_t dx = 0, int16_t dy = 0) {
+    dibujarSprite(fb, SCREEN_WIDTH, SCREEN_HEIGHT, sprite, dx, dy);
+}
+
+static void ahoraFlecha(char direccion) {
+    switch (direccion) {
+        case 'D': dibujar(flechaArriba); break;
+        case 'U': dibujar(flechaAbajo); break;
+        case 'R': dibujar(flechaIzquierda); break;
+        default: dibujar(flechaDerecha); break;
+    }
+}
+
+static void ahoraEspera(uint16_t cuadro) {
+    const Punto& p = giroEspera.p[cuadro % 30];
+    dibujar(circuloEspera, p.x, p.y);
+}
+
+static void ahoraInicio(uint16_t cuadro) {
+    const Punto& p = giroInicio.p[cuadro % 15];
+    dibujar(circuloInicio, p.x, p.y);
+}
+
+// ---------------------------------------------------------------------------
+// Medición
+// ---------------------------------------------------------------------------
+
+static int fallas = 0;
+static volatile uint32_t sumidero; // Que el compilador no descarte los cuadros
+
+static int diferencias(const uint8_t* a, const uint8_t* b) {
+    int n = 0;
+    for (size_t i = 0; i < sizeof(fb); i++) n += __builtin_popcount((unsigned)(a[i] ^ b[i]));
+    return n;
+}
+
+template <typename Dibujo>
+static double nsPorCuadro(uint32_t repeticiones, Dibujo dibujo) {
+    uint32_t suma = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < repeticiones; i++) {
+        memset(fb, 0, sizeof(fb)); // clearDisplay()
+        dibujo((uint16_t)i);
+        suma += fb[(i * 37) % sizeof(fb)];
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+    sumidero = suma;
+    return ns / repeticiones;
+}
+
+template <typename Antes, typename Ahora>
+static void comparar(const char* nombre, uint32_t repeticiones, Antes antes, Ahora ahora) {
+    double nsAntes = nsPorCuadro(repeticiones, antes);
+    double nsAhora = nsPorCuadro(repeticiones, ahora);
+    printf("%-26s %10.1f %10.1f %9.1fx\n", nombre, nsAntes, nsAhora, nsAntes / nsAhora);
+}
+
+static void verificarIguales(const char* nombre, int n) {
+    printf("%s %s: %d pixeles distintos\n", n == 0 ? "ok   " : "FALLA", nombre, n);
+    if (n != 0) fallas++;
+}
+
+int main(int argc, char** argv) {
+    uint32_t repeticiones = argc > 1 ? (uint32_t)atoi(argv[1]) : 200000;
+    if (repeticiones == 0) repeticiones = 1;
+
+    // Mismos píxeles: flechas en su lugar y círculos en cada posición de la tabla
+    uint8_t referencia[sizeof(fb)];
+    const char flechas[] = { 'U', 'D', 'L', 'R' };
+    for (char d : flechas) {
+        memset(fb, 0, sizeof(fb));
+        antesFlecha(d);
+        memcpy(referencia, fb, sizeof(fb));
+        memset(fb, 0, sizeof(fb));
+        ahoraFlecha(d);
+        char nombre[32];
+        snprintf(nombre, sizeof(nombre), "flecha %c", d);
+        verificarIguales(nombre, diferencias(referencia, fb));
+    }
+    int peorEspera = 0, peorInicio = 0;
+    for (const Punto& p : giroEspera.p) {
+        memset(fb, 0, sizeof(fb));
+        circuloRelleno(p.x, p.y, 5);
+        memcpy(referencia, fb, sizeof(fb));
+        memset(fb, 0, sizeof(fb));
+        dibujar(circuloEspera, p.x, p.y);
+        int n = diferencias(referencia, fb);
+        if (n > peorEspera) peorEspera = n;
+    }
+    for (const Punto& p : giroInicio.p) {
+        memset(fb, 0, sizeof(fb));
+        circuloRelleno(p.x, p.y, 3);
+        memcpy(referencia, fb, sizeof(fb));
+        memset(fb, 0, sizeof(fb));
+        dibujar(circuloInicio, p.x, p.y);
+        int n = diferencias(referencia, fb);
+        if (n > peorInicio) peorInicio = n;
+    }
+    verificarIguales("circulo de espera (r 5), peor de 30 posiciones", peorEspera);
+    verificarIguales("circulo de inicio (r 3), peor de 15 posiciones", peorInicio);
+
+    printf("\n%-26s %10s %10s %10s\n", "ns por cuadro", "antes", "ahora", "antes/ahora");
+    for (char d : flechas) {
+        char nombre[32];
+        snprintf(nombre, sizeof(nombre), "flecha %c", d);
+        comparar(nombre, repeticiones, [d](uint16_t) { antesFlecha(d); }, [d](uint16_t) { ahoraFlecha(d); });
+    }
+    comparar("espera BT (30 cuadros)", repeticiones, antesEspera, ahoraEspera);
+    comparar("inicio (15 cuadros)", repeticiones, antesInicio, ahoraInicio);
+    comparar("borrar solo (referencia)", repeticiones, [](uint16_t) {}, [](uint16_t) {});
+
+    printf("%s (%d fallas)\n", fallas == 0 ? "OK" : "FALLA", fallas);
+    return fallas == 0 ? 0 : 1;
+}
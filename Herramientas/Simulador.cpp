@@ -0,0 +1,226 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Simulador de PC
+
+  Descripción:
+  Compila principal.cpp sin cambios contra la HAL de PC (HalHost.h) y ejecuta
+  sus tareas con un reloj simulado: un tick de control por milisegundo, una
+  pasada de pantalla cada 5 ms y una de fondo cada 20 ms, como en el ESP32.
+  Sirve para medir en el PC el tiempo entre la llegada de un comando y la
+  primera escritura PWM que provoca.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o Simulador Simulador.cpp ../Codigos/principal.cpp
+    ./Simulador guion.txt [pwm.csv [salida.bin]]
+                                      Reproduce un guion con reloj simulado
+    ./Simulador --udp 5000            Tiempo real: comandos por UDP al puerto 5000
+                                      (p. ej. echo U | nc -u localhost 5000)
+    ./Simulador --socket /tmp/futbot  Tiempo real: comandos por un socket Unix
+                                      (p. ej. nc -U /tmp/futbot)
+  Opción -q antes de los argumentos: silencia el Serial del robot.
+
+  Formato de guion.txt, un evento por línea ('#' inicia un comentario):
+    <ms> conectar | desconectar
+    <ms> bloquear <n>            La tarea de control no corre durante n ms
+                                 (el vigilante de hardware sí)
+    <ms> hex A5 01 04 01 ...     Bytes en hexadecimal (tramas binarias)
+    <ms> <texto>                 Comando ASCII, se envía seguido de '\n'
+  La simulación termina 1 s después del último evento. pwm.csv recibe todas
+  las escrituras PWM (us,pin,duty); salida.bin, todo lo que el robot envió
+  por el enlace (sin él se imprime al final).
+  Si se reprodujo alguna macro (comandos G/P) se informa la mayor desviación
+  entre el tiempo grabado de cada paso y el tick en que se aplicó; si pasa de
+  un tick el simulador termina con código 2.
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "Hal.h"
+#include "Configuracion.h"
+#include "Macro.h"
+
+// principal.cpp
+void setup();
+void pasoTareaControl();
+void pasoTareaUI();
+void pasoTareaFondo();
+extern hal::EnlaceBT SerialBT;
+extern Transporte* enlace;
+extern ReproductorMacro reproductorMacro;
+
+struct Evento {
+    uint32_t ms;
+    int conexion; // 1 conectar, 0 desconectar, -1 datos, 2 bloquear
+    uint32_t bloqueoMs;
+    std::vector<uint8_t> datos;
+};
+
+static bool leerGuion(const char* ruta, std::vector<Evento>& eventos) {
+    FILE* f = fopen(ruta, "r");
+    if (!f) { perror(ruta); return false; }
+    char linea[256];
+    int numeroLinea = 0;
+    while (fgets(linea, sizeof(linea), f)) {
+        numeroLinea++;
+        char* comentario = strchr(linea, '#');
+        if (comentario) *comentario = '\0';
+        linea[strcspn(linea, "\r\n")] = '\0';
+        unsigned ms;
+        int usados = 0;
+        if (sscanf(linea, "%u %n", &ms, &usados) < 1) continue;
+        const char* resto = linea + usados;
+        Evento ev = { ms, -1, 0, {} };
+        if (strcmp(resto, "conectar") == 0) ev.conexion = 1;
+        else if (sscanf(resto, "bloquear %u", &ev.bloqueoMs) == 1) ev.conexion = 2;
+        else if (strcmp(resto, "desconectar") == 0) ev.conexion = 0;
+        else if (strncmp(resto, "hex ", 4) == 0) {
+            unsigned byte;
+            int n;
+            for (const char* p = resto + 4; sscanf(p, "%x%n", &byte, &n) == 1; p += n) ev.datos.push_back((uint8_t)byte);
+        } else if (*resto) {
+            ev.datos.assign(resto, resto + strlen(resto));
+            ev.datos.push_back('\n');
+        } else {
+            fprintf(stderr, "Linea %d invalida\n", numeroLinea);
+            fclose(f);
+            return false;
+        }
+        eventos.push_back(ev);
+    }
+    fclose(f);
+    std::stable_sort(eventos.begin(), eventos.end(), [](const Evento& a, const Evento& b) { return a.ms < b.ms; });
+    return true;
+}
+
+static uint64_t percentil(std::vector<uint64_t> v, unsigned p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[(v.size() - 1) * p / 100];
+}
+
+static int simularGuion(const char* ruta, const char* rutaCsv, const char* rutaSalida) {
+    std::vector<Evento> eventos;
+    if (!leerGuion(ruta, eventos)) return 1;
+    uint32_t fin = (eventos.empty() ? 0 : eventos.back().ms) + 1000;
+
+    setup();
+    std::vector<uint64_t> latencias;    // us simulados: comando -> primera escritura PWM
+    std::vector<uint64_t> tiemposPaso;  // ns reales por tick de control
+    size_t siguiente = 0, comandos = 0;
+    bool esperandoPwm = false;
+    uint64_t inicioComando = 0;
+    uint32_t bloqueadoHasta = 0;
+
+    for (uint32_t ms = 0; ms <= fin; ms++) {
+        hal::relojUs = (uint64_t)ms * 1000;
+        for (; siguiente < eventos.size() && eventos[siguiente].ms <= ms; siguiente++) {
+            const Evento& ev = eventos[siguiente];
+            if (ev.conexion == 2) { bloqueadoHasta = ms + ev.bloqueoMs; continue; }
+            if (ev.conexion >= 0) { SerialBT.conectar(ev.conexion == 1); continue; }
+            SerialBT.inyectar(ev.datos.data(), ev.datos.size());
+            comandos++;
+            esperandoPwm = true;
+            inicioComando = hal::relojUs;
+        }
+        hal::simularVigilante();
+        if (ms >= bloqueadoHasta) {
+            size_t escrituras = hal::registroPwm.size();
+            auto t0 = std::chrono::steady_clock::now();
+            pasoTareaControl();
+            auto t1 = std::chrono::steady_clock::now();
+            tiemposPaso.push_back((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            if (esperandoPwm && hal::registroPwm.size() > escrituras) {
+                latencias.push_back(hal::registroPwm[escrituras].us - inicioComando);
+                esperandoPwm = false;
+            }
+        }
+        if (ms % periodoUI == 0) pasoTareaUI();
+        if (ms % periodoFondo == 0) pasoTareaFondo();
+    }
+    pasoTareaFondo();
+
+    printf("Simulados %u ms, %zu comandos, %zu escrituras PWM\n", fin, comandos, hal::registroPwm.size());
+    printf("Latencia comando->PWM (us simulados, %zu medidas): p50 %llu  p99 %llu  max %llu\n", latencias.size(),
+           (unsigned long long)percentil(latencias, 50), (unsigned long long)percentil(latencias, 99),
+           (unsigned long long)percentil(latencias, 100));
+    printf("Disparos del vigilante: %zu\n", hal::disparosVigilante.size());
+    bool macroFueraDeTiempo = reproductorMacro.desviacionMaxMs() > 1; // Un tick de control
+    if (reproductorMacro.reproducidos() > 0) {
+        printf("Macros: %lu pasos reproducidos, desviacion max %lu ms%s\n",
+               (unsigned long)reproductorMacro.reproducidos(), (unsigned long)reproductorMacro.desviacionMaxMs(),
+               macroFueraDeTiempo ? " (MAYOR QUE UN TICK)" : "");
+    }
+    printf("Tiempo por tick de control (ns reales): p50 %llu  p99 %llu  max %llu\n",
+           (unsigned long long)percentil(tiemposPaso, 50), (unsigned long long)percentil(tiemposPaso, 99),
+           (unsigned long long)percentil(tiemposPaso, 100));
+
+    if (rutaSalida) {
+        FILE* f = fopen(rutaSalida, "wb");
+        if (!f) { perror(rutaSalida); return 1; }
+        fwrite(SerialBT.salida.data(), 1, SerialBT.salida.size(), f);
+        fclose(f);
+    } else if (!SerialBT.salida.empty()) {
+        printf("Respuestas del robot:\n");
+        fwrite(SerialBT.salida.data(), 1, SerialBT.salida.size(), stdout);
+    }
+
+    if (rutaCsv) {
+        FILE* csv = fopen(rutaCsv, "w");
+        if (!csv) { perror(rutaCsv); return 1; }
+        fprintf(csv, "us,pin,duty\n");
+        for (const hal::EscrituraPwm& w : hal::registroPwm) {
+            fprintf(csv, "%llu,%u,%u\n", (unsigned long long)w.us, w.pin, w.duty);
+        }
+        fclose(csv);
+    }
+    return macroFueraDeTiempo ? 2 : 0;
+}
+
+static int simularTiempoReal() {
+    setup();
+    auto inicio = std::chrono::steady_clock::now();
+    for (uint64_t ms = 0;; ms++) {
+        std::this_thread::sleep_until(inicio + std::chrono::milliseconds(ms));
+        hal::relojUs = ms * 1000;
+        hal::simularVigilante();
+        size_t escrituras = hal::registroPwm.size();
+        pasoTareaControl();
+        if (ms % periodoUI == 0) pasoTareaUI();
+        if (ms % periodoFondo == 0) pasoTareaFondo();
+        if (hal::registroPwm.size() > escrituras) {
+            printf("%8llu ms  M1 %3u/%3u  M2 %3u/%3u\n", (unsigned long long)ms, hal::dutyPwm[M1_IN1_CHANNEL],
+                   hal::dutyPwm[M1_IN2_CHANNEL], hal::dutyPwm[M2_IN1_CHANNEL], hal::dutyPwm[M2_IN2_CHANNEL]);
+            hal::registroPwm.clear(); // En tiempo real solo interesa el estado actual
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int a = 1;
+    if (a < argc && strcmp(argv[a], "-q") == 0) { Serial.activa = false; a++; }
+    if (a + 1 < argc && strcmp(argv[a], "--udp") == 0) {
+        uint16_t puerto = (uint16_t)atoi(argv[a + 1]);
+        if (!SerialBT.escucharUdp(puerto)) { perror("UDP"); return 1; }
+        fprintf(stderr, "Escuchando UDP en el puerto %u (Ctrl+C para salir)\n", puerto);
+        return simularTiempoReal();
+    }
+    if (a + 1 < argc && strcmp(argv[a], "--socket") == 0) {
+        static hal::TransporteSocket socketUnix;
+        if (!socketUnix.escuchar(argv[a + 1])) { perror(argv[a + 1]); return 1; }
+        enlace = &socketUnix;
+        fprintf(stderr, "Escuchando en %s (Ctrl+C para salir)\n", argv[a + 1]);
+        return simularTiempoReal();
+    }
+    if (a < argc) return simularGuion(argv[a], a + 1 < argc ? argv[a + 1] : NULL, a + 2 < argc ? argv[a + 2] : NULL);
+    fprintf(stderr, "Uso: %s [-q] guion.txt [pwm.csv [salida.bin]] | [-q] --udp <puerto> | [-q] --socket <ruta>\n",
+            argv[0]);
+    return 1;
+}
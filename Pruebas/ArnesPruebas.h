@@ -0,0 +1,90 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Arnés de las pruebas de PC
+
+  Descripción:
+  Lo que comparten las pruebas de Pruebas/ (y las mediciones que compilan
+  el firmware):
+  - verificar(condicion, descripcion): imprime "ok" o "FALLA" y cuenta las
+    fallas; terminarPrueba() imprime el resumen y devuelve el código de
+    salida de main (0 si todo pasa, 1 si algo falla).
+  - Firmware con reloj simulado, para las pruebas que compilan principal.cpp
+    contra la HAL de PC: iniciarFirmware() corre setup() sin eco por
+    Serial; tick() avanza un tick de control (1 ms) en el mismo orden que el
+    simulador: datos del enlace, vigilante, tarea de control, tarea de
+    pantalla cada periodoUI y tarea de fondo cada periodoFondo
+    (Configuracion.h). avanzar(), avanzarHasta() y tickComando() lo repiten
+    o le pasan una línea ASCII.
+  Las funciones son inline: una prueba que no compila principal.cpp puede
+  incluir este archivo sin que le falten las tareas al enlazar.
+  ============================================================================
+*/
+
+#ifndef ARNES_PRUEBAS_H
+#define ARNES_PRUEBAS_H
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "Hal.h"
+#include "Configuracion.h"
+
+static_assert(frecuenciaControl == 1000, "tick() avanza 1 ms por tick de control");
+
+inline int fallas = 0;
+
+inline void verificar(bool condicion, const char* descripcion) {
+    printf("%s %s\n", condicion ? "ok   " : "FALLA", descripcion);
+    if (!condicion) fallas++;
+}
+
+inline int terminarPrueba() {
+    printf("%s (%d fallas)\n", fallas == 0 ? "OK" : "FALLA", fallas);
+    return fallas == 0 ? 0 : 1;
+}
+
+// principal.cpp
+void setup();
+void pasoTareaControl();
+void pasoTareaUI();
+void pasoTareaFondo();
+extern hal::EnlaceBT SerialBT;
+
+inline uint32_t ms = 0; // Reloj simulado
+
+inline void iniciarFirmware() {
+    Serial.activa = false;
+    setup();
+}
+
+// Un tick; controlBloqueado deja solo a la "ISR" del vigilante (tarea de control colgada)
+inline void tick(const uint8_t* datos = NULL, size_t largo = 0, bool controlBloqueado = false) {
+    ms++;
+    hal::relojUs = (uint64_t)ms * 1000;
+    if (largo > 0) SerialBT.inyectar(datos, largo);
+    hal::simularVigilante();
+    if (!controlBloqueado) pasoTareaControl();
+    if (ms % periodoUI == 0) pasoTareaUI();
+    if (ms % periodoFondo == 0) pasoTareaFondo();
+}
+
+inline void tick(const std::string& datos) {
+    tick((const uint8_t*)datos.data(), datos.size());
+}
+
+// Un tick con 'texto' y '\n'
+inline void tickComando(const char* texto) {
+    tick(std::string(texto) + "\n");
+}
+
+inline void avanzarHasta(uint32_t destino) {
+    while (ms < destino) tick();
+}
+
+inline void avanzar(uint32_t duracion) {
+    avanzarHasta(ms + duracion);
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba de carga de ColaSPSC con dos hilos
+
+  Descripción:
+  Un hilo productor y uno consumidor, como las tareas de control y de
+  pantalla en los dos núcleos del ESP32, pasan millones de elementos por
+  colas pequeñas (se llenan y se vacían todo el tiempo). Comprueba:
+  - Orden: el consumidor recibe exactamente 0, 1, 2, ... sin saltos (nada
+    perdido) ni repetidos (nada duplicado).
+  - Sin elementos a medio escribir: cada elemento lleva su número y el
+    complemento, que deben coincidir.
+  - encolarTodos()/desencolarVarios(): mensajes de largo variable pasan
+    enteros y en orden (como colaTx con la telemetría y las respuestas).
+
+  Uso:
+    g++ -std=c++17 -O2 -pthread -I../Codigos -o PruebaColaSPSC PruebaColaSPSC.cpp
+    ./PruebaColaSPSC [millones]       Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include "ColaSPSC.h"
+#include "ArnesPruebas.h"
+
+// Del tamaño de EventoUI o mayor, para que una copia a medias se note
+struct Elemento {
+    uint32_t numero;
+    uint32_t complemento;
+    uint8_t relleno[8];
+};
+
+template <size_t N>
+static void pruebaElementos(uint32_t cantidad) {
+    ColaSPSC<Elemento, N> cola;
+    std::thread productor([&]() {
+        for (uint32_t i = 0; i < cantidad; i++) {
+            Elemento e;
+            e.numero = i;
+            e.complemento = ~i;
+            for (uint8_t j = 0; j < sizeof(e.relleno); j++) e.relleno[j] = (uint8_t)(i + j);
+            while (!cola.encolar(e)) std::this_thread::yield();
+        }
+    });
+
+    uint32_t esperado = 0, desordenados = 0, rotos = 0;
+    while (esperado < cantidad) {
+        Elemento e;
+        if (!cola.desencolar(e)) { std::this_thread::yield(); continue; }
+        if (e.numero != esperado) desordenados++;
+        bool roto = e.complemento != ~e.numero;
+        for (uint8_t j = 0; j < sizeof(e.relleno); j++) roto = roto || e.relleno[j] != (uint8_t)(e.numero + j);
+        if (roto) rotos++;
+        esperado = e.numero + 1;
+    }
+    productor.join();
+    Elemento sobrante;
+    bool vacia = !cola.desencolar(sobrante);
+
+    char descripcion[96];
+    snprintf(descripcion, sizeof(descripcion), "N=%zu: %lu elementos en orden, sin perdidos ni duplicados", N,
+             (unsigned long)cantidad);
+    verificar(desordenados == 0 && vacia, descripcion);
+    snprintf(descripcion, sizeof(descripcion), "N=%zu: ningun elemento a medio escribir", N);
+    verificar(rotos == 0, descripcion);
+}
+
+// Mensajes [largo][contador][contador+1]... de 1..40 bytes por una cola de bytes
+static void pruebaBloques(uint32_t mensajes) {
+    ColaSPSC<uint8_t, 256> cola;
+    std::thread productor([&]() {
+        uint8_t mensaje[40];
+        for (uint32_t i = 0; i < mensajes; i++) {
+            uint8_t largo = (uint8_t)(1 + i % sizeof(mensaje));
+            mensaje[0] = largo;
+            for (uint8_t j = 1; j < largo; j++) mensaje[j] = (uint8_t)(i + j);
+            while (!cola.encolarTodos(mensaje, largo)) std::this_thread::yield();
+        }
+    });
+
+    // El consumidor lee en trozos que no coinciden con los mensajes
+    uint32_t recibidos = 0, malos = 0;
+    uint8_t mensaje[40];
+    uint8_t enMensaje = 0;
+    uint8_t trozo[23];
+    while (recibidos < mensajes) {
+        size_t n = cola.desencolarVarios(trozo, 1 + recibidos % sizeof(trozo));
+        if (n == 0) { std::this_thread::yield(); continue; }
+        for (size_t k = 0; k < n; k++) {
+            mensaje[enMensaje++] = trozo[k];
+            if (enMensaje < mensaje[0]) continue;
+            uint8_t largoEsperado = (uint8_t)(1 + recibidos % sizeof(mensaje));
+            bool bien = mensaje[0] == largoEsperado;
+            for (uint8_t j = 1; bien && j < mensaje[0]; j++) bien = mensaje[j] == (uint8_t)(recibidos + j);
+            if (!bien) malos++;
+            recibidos++;
+            enMensaje = 0;
+        }
+    }
+    productor.join();
+    verificar(malos == 0 && enMensaje == 0 && cola.vacia(), "bloques: mensajes de 1..40 bytes enteros y en orden");
+
+    uint8_t grande[256] = {};
+    verificar(!cola.encolarTodos(grande, cola.capacidad() + 1) && cola.vacia(),
+              "bloques: un mensaje mayor que la capacidad no se encola a medias");
+    verificar(cola.encolarTodos(grande, cola.capacidad()) && cola.cantidad() == cola.capacidad(),
+              "bloques: un mensaje del tamaño de la capacidad cabe en la cola vacia");
+}
+
+int main(int argc, char** argv) {
+    uint32_t millones = argc > 1 ? (uint32_t)atoi(argv[1]) : 2;
+    uint32_t cantidad = millones * 1000000;
+    pruebaElementos<2>(cantidad / 8); // Una sola posición: máxima contención
+    pruebaElementos<32>(cantidad);    // Como colaUI
+    pruebaElementos<1024>(cantidad);
+    pruebaBloques(cantidad / 4);
+    return terminarPrueba();
+}
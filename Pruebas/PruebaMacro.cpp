@@ -0,0 +1,141 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba de grabación y reproducción de macros
+
+  Descripción:
+  Compila principal.cpp contra la HAL de PC y, con reloj simulado, graba la
+  macro G0: U, L, R, S con 150 ms entre comandos (CG200), y la reproduce con
+  P0. Comprueba:
+  - Grabación: la ranura tiene exactamente esos 4 pasos, con los tiempos
+    desde el primer comando y las velocidades de cada rueda.
+  - Reproducción: se reproducen los 4 pasos; cada consigna (velocidad
+    pedida y duty objetivo de cada motor) aparece en el tick P0 + tiempo
+    grabado, no antes, y ese mismo tick escribe el PWM (la rampa arranca).
+  - Interrupción: un movimiento del piloto en medio de la reproducción la
+    cancela; los pasos siguientes no se aplican y el robot sigue el comando
+    del piloto.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaMacro PruebaMacro.cpp ../Codigos/principal.cpp
+    ./PruebaMacro                     Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include "ArnesPruebas.h"
+#include "Motor.h"
+#include "Macro.h"
+
+// principal.cpp (mismo tipo de 'ruedas': si cambia, no enlaza)
+extern TablasCalibracion calibracion;
+typedef Motor<M1_IN1_CHANNEL, M1_IN2_CHANNEL, RasgosMotor<false, CompensacionTabla<&calibracion, 0> > > MotorDerecho;
+typedef Motor<M2_IN1_CHANNEL, M2_IN2_CHANNEL, RasgosMotor<false, CompensacionTabla<&calibracion, 1> > > MotorIzquierdo;
+extern DiffDrive<MotorDerecho, MotorIzquierdo> ruedas;
+extern Macro macros[MACROS_MAX];
+extern ReproductorMacro reproductorMacro;
+
+const int16_t velocidad = 200;
+const uint32_t separacion = 150; // ms entre comandos al grabar
+const char* const comandos[] = { "U", "L", "R", "S" };
+const PasoMacro esperados[] = {
+    { 0, velocidad, velocidad },
+    { separacion, -velocidad, velocidad },
+    { 2 * separacion, velocidad, -velocidad },
+    { 3 * separacion, 0, 0 },
+};
+const uint8_t pasosEsperados = sizeof(esperados) / sizeof(esperados[0]);
+
+static bool consignaEs(int16_t duty1, int16_t duty2) {
+    return ruedas.motor1.pedido() == duty1 && ruedas.motor2.pedido() == duty2 &&
+           ruedas.motor1.objetivo() == CompensacionTabla<&calibracion, 0>::aplicar(duty1) &&
+           ruedas.motor2.objetivo() == CompensacionTabla<&calibracion, 1>::aplicar(duty2);
+}
+
+// ¿Hubo escrituras PWM en el tick actual a partir de 'desde'?
+static bool pwmEnEsteTick(size_t desde) {
+    for (size_t i = desde; i < hal::registroPwm.size(); i++) {
+        if (hal::registroPwm[i].us == hal::relojUs) return true;
+    }
+    return false;
+}
+
+static void grabar() {
+    tickComando("CG200");
+    avanzar(100);
+    tickComando("G0");
+    avanzar(100);
+    uint32_t inicio = ms + 1;
+    for (uint8_t i = 0; i < pasosEsperados; i++) {
+        avanzarHasta(inicio + i * separacion - 1);
+        tickComando(comandos[i]);
+    }
+    avanzar(50);
+    tickComando("GS");
+    avanzar(100);
+
+    const Macro& m = macros[0];
+    verificar(m.cantidad == pasosEsperados, "grabacion: 4 pasos (U, L, R, S)");
+    bool iguales = m.cantidad == pasosEsperados;
+    for (uint8_t i = 0; iguales && i < pasosEsperados; i++) {
+        iguales = m.pasos[i].ms == esperados[i].ms && m.pasos[i].duty1 == esperados[i].duty1 &&
+                  m.pasos[i].duty2 == esperados[i].duty2;
+    }
+    verificar(iguales, "grabacion: tiempos y velocidades de cada paso");
+}
+
+static void reproducir() {
+    avanzar(1000); // Parado y fuera de la rampa
+    uint32_t antes = reproductorMacro.reproducidos();
+    uint32_t inicio = ms + 1;
+    bool aTiempo = true, noAntes = true, pwm = true;
+    tickComando("P0");
+    for (uint8_t i = 0; i < pasosEsperados; i++) {
+        uint32_t tiempo = inicio + esperados[i].ms;
+        if (i > 0) {
+            avanzarHasta(tiempo - 1);
+            if (!consignaEs(esperados[i - 1].duty1, esperados[i - 1].duty2)) noAntes = false;
+            size_t desde = hal::registroPwm.size();
+            tick();
+            if (!pwmEnEsteTick(desde)) pwm = false;
+        }
+        if (!consignaEs(esperados[i].duty1, esperados[i].duty2)) aTiempo = false;
+    }
+    avanzar(10);
+    char descripcion[96];
+    snprintf(descripcion, sizeof(descripcion), "reproduccion: %lu pasos reproducidos (grabados %u)",
+             (unsigned long)(reproductorMacro.reproducidos() - antes), pasosEsperados);
+    verificar(reproductorMacro.reproducidos() - antes == pasosEsperados, descripcion);
+    verificar(aTiempo, "reproduccion: cada consigna aparece en P0 + su tiempo grabado");
+    verificar(noAntes, "reproduccion: ninguna consigna aparece antes de su tiempo");
+    verificar(pwm, "reproduccion: el PWM cambia en el mismo tick de cada consigna");
+    verificar(reproductorMacro.desviacionMaxMs() == 0, "reproduccion: desviacion de 0 ms");
+    verificar(!reproductorMacro.activo(), "reproduccion: termina tras el ultimo paso");
+}
+
+static void interrumpir() {
+    avanzar(1000);
+    uint32_t antes = reproductorMacro.reproducidos();
+    uint32_t inicio = ms + 1;
+    tickComando("P0");
+    avanzarHasta(inicio + separacion + separacion / 3 - 1);
+    verificar(reproductorMacro.activo(), "interrupcion: la macro se esta reproduciendo");
+    tickComando("D"); // Entre L y R
+    verificar(!reproductorMacro.activo(), "interrupcion: el movimiento del piloto cancela la macro");
+    avanzarHasta(inicio + esperados[pasosEsperados - 1].ms + 10);
+    verificar(reproductorMacro.reproducidos() - antes == 2, "interrupcion: solo se reprodujeron U y L");
+    verificar(consignaEs(-velocidad, -velocidad), "interrupcion: R y S no se aplican, sigue D");
+}
+
+int main() {
+    iniciarFirmware();
+    SerialBT.conectar(true);
+    avanzar(2000); // Animación de conexión
+
+    grabar();
+    reproducir();
+    interrumpir();
+
+    return terminarPrueba();
+}
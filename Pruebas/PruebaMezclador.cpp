@@ -0,0 +1,120 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba exhaustiva del mezclador arcade
+
+  Descripción:
+  Evalúa mezclarArcade() (Mezclador.h) en todas las combinaciones de
+  acelerador y giro (-128..127) para varias curvas expo, incluida la del
+  firmware, y curvaExpo() con todas las entradas y todos los expo.
+  Comprueba:
+  - Rango: ambos duty en -255..255; extremos exactos (127 -> 255).
+  - Simetría: invertir acelerador y giro invierte ambos duty; invertir
+    solo el giro intercambia las ruedas. -128 se comporta como -127.
+  - Monotonía: más acelerador nunca baja un duty; más giro nunca baja
+    duty1 ni sube duty2.
+  - Relación entre ruedas: al saturar, cada duty es el valor exacto
+    (acelerador + giro) * 255 / mayor redondeado (error <= 0,5).
+  - Curva: impar, monótona, lineal con expo 0 y a <= 0,5 de la fórmula
+    en coma flotante (redondeo correcto).
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaMezclador PruebaMezclador.cpp
+    ./PruebaMezclador                 Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Mezclador.h"
+#include "ArnesPruebas.h"
+
+static void pruebaCurva() {
+    bool impar = true, monotona = true, extremos = true, lineal = true, cercana = true;
+    double peorError = 0;
+    for (uint16_t expo = 0; expo < 256; expo++) {
+        int16_t anterior = -32768;
+        for (int16_t x = -128; x <= 127; x++) {
+            int16_t y = curvaExpo((int8_t)x, (uint8_t)expo);
+            if (x > -128 && y != -curvaExpo((int8_t)-x, (uint8_t)expo)) impar = false;
+            if (x == -128 && y != curvaExpo(-127, (uint8_t)expo)) impar = false;
+            if (y < anterior) monotona = false;
+            anterior = y;
+            if (expo == 0 && y != (int16_t)lround(x < -127 ? -255.0 : x * 255.0 / 127.0)) lineal = false;
+            double v = x < -127 ? -127 : x;
+            double e = expo / 256.0;
+            double ideal = ((1 - e) * v + e * v * v * v / (127.0 * 127.0)) * 255.0 / 127.0;
+            double error = fabs(y - ideal);
+            if (error > peorError) peorError = error;
+            if (error > 0.5 + 1e-9) cercana = false;
+        }
+        if (curvaExpo(127, (uint8_t)expo) != 255 || curvaExpo(-127, (uint8_t)expo) != -255 ||
+            curvaExpo(0, (uint8_t)expo) != 0) extremos = false;
+    }
+    verificar(impar, "curva: impar (-128 como -127) con todos los expo");
+    verificar(monotona, "curva: monotona con todos los expo");
+    verificar(extremos, "curva: 0 -> 0 y +-127 -> +-255 con todos los expo");
+    verificar(lineal, "curva: expo 0 es x * 255 / 127 redondeado");
+    char descripcion[96];
+    snprintf(descripcion, sizeof(descripcion), "curva: error contra coma flotante %.3f (<= 0,5)", peorError);
+    verificar(cercana, descripcion);
+}
+
+static void pruebaMezcla(const char* nombre, ConfigMezcla c) {
+    static DutyRuedas tabla[256][256]; // [acelerador + 128][giro + 128]
+    for (int16_t a = -128; a <= 127; a++) {
+        for (int16_t g = -128; g <= 127; g++) tabla[a + 128][g + 128] = mezclarArcade((int8_t)a, (int8_t)g, c);
+    }
+    auto m = [&](int16_t a, int16_t g) -> const DutyRuedas& { return tabla[a + 128][g + 128]; };
+
+    bool rango = true, simetria = true, menos128 = true, monotona = true, relacion = true;
+    for (int16_t a = -128; a <= 127; a++) {
+        for (int16_t g = -128; g <= 127; g++) {
+            const DutyRuedas& d = m(a, g);
+            if (abs(d.duty1) > 255 || abs(d.duty2) > 255) rango = false;
+            if (a > -128 && g > -128) {
+                const DutyRuedas& opuesto = m(-a, -g);
+                const DutyRuedas& espejo = m(a, -g);
+                if (opuesto.duty1 != -d.duty1 || opuesto.duty2 != -d.duty2) simetria = false;
+                if (espejo.duty1 != d.duty2 || espejo.duty2 != d.duty1) simetria = false;
+            }
+            if (a == -128 && (d.duty1 != m(-127, g).duty1 || d.duty2 != m(-127, g).duty2)) menos128 = false;
+            if (g == -128 && (d.duty1 != m(a, -127).duty1 || d.duty2 != m(a, -127).duty2)) menos128 = false;
+            if (a > -128 && (d.duty1 < m(a - 1, g).duty1 || d.duty2 < m(a - 1, g).duty2)) monotona = false;
+            if (g > -128 && (d.duty1 < m(a, g - 1).duty1 || d.duty2 > m(a, g - 1).duty2)) monotona = false;
+
+            // Mismo cálculo sin saturar; al saturar, cada rueda a <= 0,5 del valor exacto
+            int32_t ca = curvaExpo((int8_t)a, c.expoAcelerador), cg = curvaExpo((int8_t)g, c.expoGiro);
+            int32_t d1 = ca + cg, d2 = ca - cg;
+            int32_t mayor = abs(d1) > abs(d2) ? abs(d1) : abs(d2);
+            if (mayor <= 255) {
+                if (d.duty1 != d1 || d.duty2 != d2) relacion = false;
+            } else if (abs(2 * d.duty1 * mayor - 2 * d1 * 255) > mayor || abs(2 * d.duty2 * mayor - 2 * d2 * 255) > mayor) {
+                relacion = false;
+            }
+        }
+    }
+    bool extremos = m(127, 0).duty1 == 255 && m(127, 0).duty2 == 255 && m(-127, 0).duty1 == -255 &&
+                    m(0, 127).duty1 == 255 && m(0, 127).duty2 == -255 && m(0, 0).duty1 == 0 && m(0, 0).duty2 == 0 &&
+                    m(127, 127).duty1 == 255 && m(127, 127).duty2 == 0;
+
+    char descripcion[128];
+    snprintf(descripcion, sizeof(descripcion), "%s (expo %u/%u): 65536 entradas", nombre, c.expoAcelerador, c.expoGiro);
+    printf("      %s\n", descripcion);
+    verificar(rango && extremos, "  rango -255..255 y extremos exactos");
+    verificar(simetria && menos128, "  simetrias y -128 como -127");
+    verificar(monotona, "  monotona en acelerador y en giro");
+    verificar(relacion, "  relacion entre ruedas (error <= 0,5 al saturar)");
+}
+
+int main() {
+    pruebaCurva();
+    pruebaMezcla("firmware", ConfigMezcla{ 64, 96 });
+    pruebaMezcla("lineal", ConfigMezcla{ 0, 0 });
+    pruebaMezcla("casi cubica", ConfigMezcla{ 255, 255 });
+    pruebaMezcla("mixta", ConfigMezcla{ 0, 255 });
+    pruebaMezcla("mixta", ConfigMezcla{ 200, 17 });
+    return terminarPrueba();
+}
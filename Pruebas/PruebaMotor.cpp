@@ -0,0 +1,213 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba de las secuencias de duty de Motor / DiffDrive
+
+  Descripción:
+  Instancia Motor<> y DiffDrive<> (Motor.h) contra la HAL de PC, con tablas
+  de calibración con zona muerta distinta por motor y sentido, un motor
+  invertido y uno sin compensación. Recorre tick a tick todos los pares
+  inicio/objetivo de una grilla (incluidas las inversiones de sentido) y
+  comprueba en cada tick, sobre las escrituras PWM registradas:
+  - Rampa acotada: la velocidad de la rampa cambia como mucho velMax por
+    tick, sin sobrepasar el objetivo, y llega a él dentro de la cota.
+  - Duty = compensación de la velocidad de la rampa: una consulta a la
+    tabla por tick; ningún duty cae dentro de la zona muerta (la cruza de
+    un salto).
+  - Pines: el signo elige el pin (intercambiado si el motor es invertido) y
+    nunca hay dos pines de un motor distintos de 0 a la vez.
+  - DiffDrive: las escrituras de un tick van seguidas, motor 1 y motor 2.
+  - Parada: velocidad 0 es duty 0 en ambos pines, aunque la entrada 0 de la
+    tabla esté corrupta.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaMotor PruebaMotor.cpp
+    ./PruebaMotor                     Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Hal.h"
+#include "Motor.h"
+#include "ArnesPruebas.h"
+
+TablasCalibracion tablas;
+
+typedef Motor<4, 2, RasgosMotor<false, CompensacionTabla<&tablas, 0> > > MotorDerecho;
+typedef Motor<27, 26, RasgosMotor<true, CompensacionTabla<&tablas, 1> > > MotorIzquierdo; // Montado al revés
+DiffDrive<MotorDerecho, MotorIzquierdo> ruedas;
+DiffDrive<Motor<12, 13>, Motor<14, 15> > ruedasSinCompensacion;
+
+struct Resultado {
+    uint32_t casos = 0;
+    uint32_t rampa = 0;       // Paso mayor que velMax o sobrepaso
+    uint32_t convergencia = 0;
+    uint32_t duty = 0;        // Duty distinto de la compensación de la velocidad
+    uint32_t zonaMuerta = 0;
+    uint32_t pines = 0;
+    uint32_t seguidas = 0;    // Escrituras de un tick fuera de orden
+    uint32_t maxTicks = 0;
+    bool hayEjemplo = false;
+    int16_t ejemploInicio = 0, ejemploObjetivo = 0;
+
+    uint32_t errores() const { return rampa + convergencia + duty + zonaMuerta + pines + seguidas; }
+};
+
+// Duty mínimo distinto de 0 de cada motor y sentido (borde de la zona muerta)
+static int16_t zonaMuerta(uint8_t motor, int16_t duty) {
+    return tablas.tabla[indiceTabla(motor, duty > 0 ? 0 : 1)][1];
+}
+
+template <typename M>
+static bool pinesBien(const M& m) {
+    uint8_t pinAdelante = M::pinAdelante, pinAtras = M::pinAtras; // Copias: dutyPwm[] toma referencias
+    uint32_t adelante = hal::dutyPwm[pinAdelante], atras = hal::dutyPwm[pinAtras];
+    if (m.duty() > 0) return adelante == (uint32_t)m.duty() && atras == 0;
+    if (m.duty() < 0) return atras == (uint32_t)-m.duty() && adelante == 0;
+    return adelante == 0 && atras == 0;
+}
+
+// Pasos de la rampa, en enteros, acotados por velMax (Q8)
+static int16_t pasoMaximo(const ConfigRampa& c) {
+    return (int16_t)((c.velMax + 255) / 256);
+}
+
+static uint32_t cotaTicks(const ConfigRampa& c) {
+    uint32_t recorrido = (uint32_t)(2 * 255 * 256 / c.velMax) + 2;
+    uint32_t acelerar = c.acelMax > 0 ? (uint32_t)(c.velMax / c.acelMax + 1) : 0;
+    return recorrido + 4 * acelerar + 4;
+}
+
+// Ambos motores desde el reposo en 'inicio' hacia 'objetivo' (el izquierdo, en espejo)
+template <typename D>
+static void recorrer(D& d, bool compensado, int16_t inicio, int16_t objetivo, const ConfigRampa& c, Resultado& r) {
+    typedef decltype(d.motor1) Motor1;
+    d.forzar(inicio, (int16_t)-inicio);
+    d.fijar(objetivo, (int16_t)-objetivo);
+    hal::registroPwm.clear();
+    uint32_t cota = cotaTicks(c);
+    uint32_t llegada = 0;
+    bool fallo = false;
+    int16_t antes1 = d.motor1.velocidad(), antes2 = d.motor2.velocidad();
+
+    for (uint32_t t = 1; t <= cota + 20; t++) {
+        hal::relojUs += 1000;
+        size_t desde = hal::registroPwm.size();
+        int16_t duty1 = d.motor1.duty(), duty2 = d.motor2.duty();
+        d.actualizar(c);
+        bool cambio1 = d.motor1.duty() != duty1;
+        bool cambio2 = d.motor2.duty() != duty2;
+
+        int16_t v1 = d.motor1.velocidad(), v2 = d.motor2.velocidad();
+        int16_t paso = pasoMaximo(c);
+        bool rampaBien = abs(v1 - antes1) <= paso && abs(v2 - antes2) <= paso;
+        // Desde el reposo hacia un objetivo fijo: nunca se aleja ni lo pasa
+        if (objetivo >= inicio) rampaBien = rampaBien && v1 >= antes1 && v1 <= objetivo && v2 <= antes2 && v2 >= -objetivo;
+        else rampaBien = rampaBien && v1 <= antes1 && v1 >= objetivo && v2 >= antes2 && v2 <= -objetivo;
+        if (!rampaBien) { r.rampa++; fallo = true; }
+        antes1 = v1;
+        antes2 = v2;
+
+        int16_t esperado1 = compensado ? (v1 == 0 ? 0 : aplicarCalibracion(tablas, 0, v1)) : v1;
+        int16_t esperado2 = compensado ? (v2 == 0 ? 0 : aplicarCalibracion(tablas, 1, v2)) : v2;
+        if (d.motor1.duty() != esperado1 || d.motor2.duty() != esperado2) { r.duty++; fallo = true; }
+        if (compensado) {
+            int16_t a = d.motor1.duty(), b = d.motor2.duty();
+            if ((a != 0 && abs(a) < zonaMuerta(0, a)) || (b != 0 && abs(b) < zonaMuerta(1, b))) {
+                r.zonaMuerta++;
+                fallo = true;
+            }
+        }
+        if (!pinesBien(d.motor1) || !pinesBien(d.motor2)) { r.pines++; fallo = true; }
+
+        // Escrituras del tick: dos por motor que cambió, primero el 1 y después el 2, sin nada en medio
+        size_t escritas = hal::registroPwm.size() - desde;
+        size_t esperadas = (cambio1 ? 2 : 0) + (cambio2 ? 2 : 0);
+        bool enOrden = escritas == esperadas;
+        for (size_t i = 0; enOrden && i < escritas; i++) {
+            uint8_t pin = hal::registroPwm[desde + i].pin;
+            bool delUno = pin == Motor1::pinAdelante || pin == Motor1::pinAtras;
+            enOrden = (cambio1 && i < 2) ? delUno : !delUno;
+        }
+        if (!enOrden) { r.seguidas++; fallo = true; }
+
+        bool enObjetivo = !d.enRampa() && v1 == objetivo && v2 == -objetivo;
+        if (enObjetivo && llegada == 0) llegada = t;
+        if (!enObjetivo && llegada != 0) { llegada = 0; r.convergencia++; fallo = true; } // Se fue
+    }
+    if (llegada == 0 || llegada > cota) { r.convergencia++; fallo = true; }
+    if (llegada > r.maxTicks) r.maxTicks = llegada;
+    if (fallo && !r.hayEjemplo) {
+        r.hayEjemplo = true;
+        r.ejemploInicio = inicio;
+        r.ejemploObjetivo = objetivo;
+    }
+    r.casos++;
+}
+
+template <typename D>
+static void grilla(const char* nombre, D& d, bool compensado, const ConfigRampa& c) {
+    Resultado r;
+    for (int16_t inicio = -255; inicio <= 255; inicio += 15) {
+        for (int16_t objetivo = -255; objetivo <= 255; objetivo += 5) recorrer(d, compensado, inicio, objetivo, c, r);
+    }
+    char descripcion[160];
+    snprintf(descripcion, sizeof(descripcion), "%s: %lu casos, max %lu ticks (cota %lu)", nombre,
+             (unsigned long)r.casos, (unsigned long)r.maxTicks, (unsigned long)cotaTicks(c));
+    verificar(r.errores() == 0, descripcion);
+    if (r.errores() != 0) {
+        printf("      rampa %lu, convergencia %lu, duty %lu, zona muerta %lu, pines %lu, orden %lu (p. ej. %d -> %d)\n",
+               (unsigned long)r.rampa, (unsigned long)r.convergencia, (unsigned long)r.duty,
+               (unsigned long)r.zonaMuerta, (unsigned long)r.pines, (unsigned long)r.seguidas, r.ejemploInicio,
+               r.ejemploObjetivo);
+    }
+}
+
+// Zona muerta y tope distintos por motor y sentido, como motores reales
+static void cargarTablas() {
+    const PuntoCalibracion puntos[CAL_TABLAS][5] = {
+        { { 0, 0 }, { 60, 0 }, { 61, 20 }, { 150, 400 }, { 255, 900 } },  // Derecho adelante
+        { { 0, 0 }, { 70, 0 }, { 71, 15 }, { 160, 380 }, { 255, 850 } },  // Derecho atrás
+        { { 0, 0 }, { 45, 0 }, { 46, 30 }, { 140, 450 }, { 255, 1000 } }, // Izquierdo adelante
+        { { 0, 0 }, { 90, 0 }, { 91, 10 }, { 200, 500 }, { 255, 800 } },  // Izquierdo atrás
+    };
+    for (uint8_t i = 0; i < CAL_TABLAS; i++) generarTablaCalibracion(puntos[i], 5, 800, tablas.tabla[i]);
+}
+
+int main() {
+    cargarTablas();
+    ruedas.iniciar(1000, 8);
+    ruedasSinCompensacion.iniciar(1000, 8);
+
+    verificar(MotorIzquierdo::pinAdelante == 26 && MotorIzquierdo::pinAtras == 27 && MotorDerecho::pinAdelante == 4,
+              "invertido intercambia In1/In2 al compilar");
+    bool bordes = true;
+    for (uint8_t i = 0; i < CAL_TABLAS; i++) bordes = bordes && tablas.tabla[i][0] == 0 && tablas.tabla[i][1] > 1;
+    verificar(bordes, "tablas de prueba con zona muerta en los cuatro sentidos");
+
+    const ConfigRampa firmware = configurarRampa(150, 50, 1000);
+    grilla("firmware (150/50 ms), compensado", ruedas, true, firmware);
+    grilla("solo pendiente 150 ms, compensado", ruedas, true, configurarRampa(150, 0, 1000));
+    grilla("firmware, sin compensacion", ruedasSinCompensacion, false, firmware);
+
+    // Parada con la entrada 0 corrupta: ni detener() ni la rampa a 0 la consultan
+    for (uint8_t i = 0; i < CAL_TABLAS; i++) tablas.tabla[i][0] = 77;
+    ruedas.forzar(200, -200);
+    ruedas.detener();
+    bool detenido = pinesBien(ruedas.motor1) && pinesBien(ruedas.motor2) && ruedas.motor1.duty() == 0 &&
+                    ruedas.motor2.duty() == 0;
+    verificar(detenido, "detener(): duty 0 en los cuatro pines con la entrada 0 corrupta");
+    ruedas.forzar(200, -200);
+    ruedas.fijar(0, 0);
+    for (uint32_t t = 0; t < cotaTicks(firmware); t++) {
+        hal::relojUs += 1000;
+        ruedas.actualizar(firmware);
+    }
+    detenido = !ruedas.enRampa() && ruedas.motor1.duty() == 0 && ruedas.motor2.duty() == 0 &&
+               pinesBien(ruedas.motor1) && pinesBien(ruedas.motor2);
+    verificar(detenido, "rampa a 0: termina en duty 0 con la entrada 0 corrupta");
+
+    return terminarPrueba();
+}
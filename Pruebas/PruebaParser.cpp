@@ -0,0 +1,130 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba del parser de comandos ASCII
+
+  Descripción:
+  Alimenta líneas a ParserComandos byte a byte y comprueba el comando o el
+  error que entrega, con las reglas del parser anterior (readStringUntil,
+  trim() y substring(2, 5).toInt()):
+  - Velocidades C1/C2/CG: 3 dígitos 000-255; más de 255 o cualquier
+    carácter que no sea dígito entre los 3 ('C1-12', 'C11a2', 'C1 12') da
+    ERR_FUERA_DE_RANGO; menos de 3 (también con espacios finales, que se
+    recortan) da ERR_C_INCOMPLETO; lo que sigue a los 3 se ignora.
+  - F/B/S con motor, S sola, U/D/L/R, X, M/MB y macros G/P.
+  - Errores: F/B/S malformados, letras desconocidas, y una 'C' sola no
+    entrega comando.
+  - Sin '\n': finalizar() cierra la línea como si hubiera llegado.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaParser PruebaParser.cpp
+    ./PruebaParser                    Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "ParserComandos.h"
+#include "ArnesPruebas.h"
+
+struct Caso {
+    const char* linea;
+    TipoComando tipo;
+    ErrorComando error;  // Con CMD_ERROR
+    char objetivo;       // Sin CMD_ERROR
+    uint8_t valor;       // Con CMD_VELOCIDAD
+};
+
+static const Caso casos[] = {
+    // Velocidades
+    { "C1255", CMD_VELOCIDAD, ERR_NINGUNO, '1', 255 },
+    { "C2000", CMD_VELOCIDAD, ERR_NINGUNO, '2', 0 },
+    { "CG128", CMD_VELOCIDAD, ERR_NINGUNO, 'G', 128 },
+    { "CG007", CMD_VELOCIDAD, ERR_NINGUNO, 'G', 7 },
+    { "C1100xyz", CMD_VELOCIDAD, ERR_NINGUNO, '1', 100 },
+    { "C1100 ", CMD_VELOCIDAD, ERR_NINGUNO, '1', 100 },
+    { "  C2200", CMD_VELOCIDAD, ERR_NINGUNO, '2', 200 },
+    { "C1256", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "CG999", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "C1-12", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "C11a2", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "C112a", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "C1abc", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "C1 12", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "C1+12", CMD_ERROR, ERR_FUERA_DE_RANGO, 0, 0 },
+    { "C112", CMD_ERROR, ERR_C_INCOMPLETO, 0, 0 },
+    { "C112 ", CMD_ERROR, ERR_C_INCOMPLETO, 0, 0 },
+    { "C1", CMD_ERROR, ERR_C_INCOMPLETO, 0, 0 },
+    { "C3100", CMD_ERROR, ERR_DESCONOCIDO, 0, 0 },
+    // Motores y movimientos
+    { "F1", CMD_MOTOR, ERR_NINGUNO, '1', 0 },
+    { "B2", CMD_MOTOR, ERR_NINGUNO, '2', 0 },
+    { "S1 ", CMD_MOTOR, ERR_NINGUNO, '1', 0 },
+    { "S", CMD_GENERAL, ERR_NINGUNO, '\0', 0 },
+    { "U", CMD_GENERAL, ERR_NINGUNO, '\0', 0 },
+    { "R", CMD_GENERAL, ERR_NINGUNO, '\0', 0 },
+    { "F3", CMD_ERROR, ERR_FBS_MALFORMADO, 0, 0 },
+    { "F12", CMD_ERROR, ERR_FBS_MALFORMADO, 0, 0 },
+    { "F", CMD_ERROR, ERR_FBS_MALFORMADO, 0, 0 },
+    // Pantalla, métricas y macros
+    { "X", CMD_PRUEBA_PANTALLA, ERR_NINGUNO, '\0', 0 },
+    { "M", CMD_METRICAS, ERR_NINGUNO, '\0', 0 },
+    { "MB", CMD_METRICAS, ERR_NINGUNO, 'B', 0 },
+    { "MX", CMD_ERROR, ERR_DESCONOCIDO, 0, 0 },
+    { "G3", CMD_MACRO, ERR_NINGUNO, '3', 0 },
+    { "GS", CMD_MACRO, ERR_NINGUNO, 'S', 0 },
+    { "P0", CMD_MACRO, ERR_NINGUNO, '0', 0 },
+    { "PS", CMD_ERROR, ERR_DESCONOCIDO, 0, 0 },
+    { "Z", CMD_ERROR, ERR_DESCONOCIDO, 0, 0 },
+};
+
+// Alimenta 'texto' y cierra la línea con '\n' o con finalizar(); devuelve si hubo comando
+static bool leer(ParserComandos& parser, const char* texto, bool conFinDeLinea, Comando& cmd) {
+    bool listo = false;
+    for (size_t i = 0; texto[i] != '\0'; i++) {
+        if (parser.alimentar((uint8_t)texto[i], cmd)) listo = true;
+    }
+    if (conFinDeLinea) return parser.alimentar('\n', cmd) || listo;
+    return parser.finalizar(cmd) || listo;
+}
+
+static bool esperado(const Caso& c, const Comando& cmd) {
+    if (cmd.tipo != c.tipo) return false;
+    if (c.tipo == CMD_ERROR) return cmd.error == c.error;
+    if (cmd.error != ERR_NINGUNO || cmd.objetivo != c.objetivo) return false;
+    return c.tipo != CMD_VELOCIDAD || cmd.valor == c.valor;
+}
+
+static void pruebaCasos(bool conFinDeLinea) {
+    ParserComandos parser;
+    for (const Caso& c : casos) {
+        Comando cmd = {};
+        bool listo = leer(parser, c.linea, conFinDeLinea, cmd);
+        char descripcion[96];
+        snprintf(descripcion, sizeof(descripcion), "\"%s\"%s", c.linea, conFinDeLinea ? "" : " (sin '\\n')");
+        verificar(listo && esperado(c, cmd), descripcion);
+        if (listo && !esperado(c, cmd)) {
+            printf("      tipo %u error %u objetivo '%c' valor %u\n", cmd.tipo, cmd.error,
+                   cmd.objetivo ? cmd.objetivo : '-', cmd.valor);
+        }
+    }
+}
+
+static void pruebaCSola() {
+    ParserComandos parser;
+    Comando cmd = {};
+    verificar(!leer(parser, "C", true, cmd), "\"C\" sola no entrega comando");
+    bool listo = leer(parser, "C1-12", true, cmd);
+    verificar(listo && cmd.tipo == CMD_ERROR && cmd.error == ERR_FUERA_DE_RANGO,
+              "tras una C sola, \"C1-12\" sigue fuera de rango");
+    listo = leer(parser, "CG050", true, cmd);
+    verificar(listo && cmd.tipo == CMD_VELOCIDAD && cmd.valor == 50, "un error no afecta al comando siguiente");
+}
+
+int main() {
+    pruebaCasos(true);
+    pruebaCasos(false);
+    pruebaCSola();
+    return terminarPrueba();
+}
@@ -0,0 +1,160 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba de la calibración y la mezcla guardadas en NVS
+
+  Descripción:
+  Compila principal.cpp contra la HAL de PC y carga tablas de calibración
+  por Bluetooth (TRAMA_CALIBRACION + TRAMA_CALIBRACION_FIN) con reloj
+  simulado. La escritura en NVS se junta y la hace la tarea de fondo
+  esperaNvs (Configuracion.h) después del último cambio. Comprueba:
+  - GUARDAR -> APLICAR -> 2 s: los motores usan las tablas de APLICAR (solo
+    prueba), pero la NVS guarda las de GUARDAR, y al recargarla
+    (cargarCalibracion(), como al reiniciar) vuelven las de GUARDAR.
+  - Nada se escribe antes de esperaNvs.
+  - GUARDAR -> GUARDAR: se guarda la última.
+  - GUARDAR -> RESTAURAR: se borra la calibración guardada.
+  - TRAMA_MEZCLA: el mando analógico usa las curvas nuevas de inmediato, se
+    guardan pasado esperaNvs y cargarMezcla() las recupera.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaPersistencia PruebaPersistencia.cpp ../Codigos/principal.cpp
+    ./PruebaPersistencia              Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include "ArnesPruebas.h"
+#include "Calibracion.h"
+#include "Mezclador.h"
+#include "Motor.h"
+#include "ProtocoloBinario.h"
+
+// principal.cpp (mismo tipo de 'ruedas': si cambia, no enlaza)
+extern TablasCalibracion calibracion;
+typedef Motor<M1_IN1_CHANNEL, M1_IN2_CHANNEL, RasgosMotor<false, CompensacionTabla<&calibracion, 0> > > MotorDerecho;
+typedef Motor<M2_IN1_CHANNEL, M2_IN2_CHANNEL, RasgosMotor<false, CompensacionTabla<&calibracion, 1> > > MotorIzquierdo;
+extern DiffDrive<MotorDerecho, MotorIzquierdo> ruedas;
+extern ConfigMezcla configMezcla;
+extern Preferences preferencias;
+extern const char* claveCalibracion;
+extern const char* claveMezcla;
+void cargarCalibracion();
+void cargarMezcla();
+
+static uint8_t seq = 0;
+
+// Tablas con un desplazamiento distinto por tabla, para distinguirlas
+static TablasCalibracion tablas(int8_t base) {
+    TablasCalibracion t;
+    for (uint8_t i = 0; i < CAL_TABLAS; i++) tablaCompensacion(t.tabla[i], (int8_t)(base + 3 * i));
+    return t;
+}
+
+static void enviarFin(AccionCalibracion accion) {
+    uint8_t trama[TRAMA_LARGO_MAX];
+    tick(trama, codificarCalibracionFin(seq++, accion, trama));
+}
+
+// Una trama por tick, como las manda la app
+static void enviarTablas(const TablasCalibracion& t, AccionCalibracion accion) {
+    uint8_t trama[TRAMA_LARGO_MAX];
+    for (uint8_t i = 0; i < CAL_TABLAS; i++) {
+        for (uint16_t posicion = 0; posicion < 256; posicion += TRAMA_CALIBRACION_VALORES_MAX) {
+            uint16_t cantidad = 256 - posicion;
+            if (cantidad > TRAMA_CALIBRACION_VALORES_MAX) cantidad = TRAMA_CALIBRACION_VALORES_MAX;
+            tick(trama, codificarCalibracion(seq++, i, (uint8_t)posicion, &t.tabla[i][posicion], (uint8_t)cantidad,
+                                             trama));
+        }
+    }
+    enviarFin(accion);
+}
+
+static bool enNvs(const TablasCalibracion& t) {
+    TablasCalibracion guardada;
+    if (preferencias.getBytesLength(claveCalibracion) != sizeof(guardada)) return false;
+    preferencias.getBytes(claveCalibracion, &guardada, sizeof(guardada));
+    return memcmp(&guardada, &t, sizeof(t)) == 0;
+}
+
+static bool iguales(const TablasCalibracion& a, const TablasCalibracion& b) {
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static bool mezclaEs(const ConfigMezcla& c, uint8_t expoAcelerador, uint8_t expoGiro) {
+    return c.expoAcelerador == expoAcelerador && c.expoGiro == expoGiro;
+}
+
+static void pruebaMezcla() {
+    const int8_t acelerador = 100, giro = 50;
+    const ConfigMezcla nueva = { 0, 200 };
+    uint8_t trama[TRAMA_LARGO_MAX];
+    DutyRuedas antes = mezclarArcade(acelerador, giro, configMezcla);
+    DutyRuedas despues = mezclarArcade(acelerador, giro, nueva);
+    verificar(antes.duty1 != despues.duty1 || antes.duty2 != despues.duty2,
+              "mezcla: las curvas de prueba dan otro duty");
+
+    tick(trama, codificarMezcla(seq++, nueva.expoAcelerador, nueva.expoGiro, trama));
+    uint32_t recibida = ms;
+    verificar(mezclaEs(configMezcla, nueva.expoAcelerador, nueva.expoGiro), "mezcla: TRAMA_MEZCLA cambia las curvas");
+    tick(trama, codificarAnalogico(seq++, acelerador, giro, trama));
+    verificar(ruedas.motor1.pedido() == despues.duty1 && ruedas.motor2.pedido() == despues.duty2,
+              "mezcla: TRAMA_ANALOGICO usa las curvas nuevas");
+    tick(trama, codificarAnalogico(seq++, 0, 0, trama));
+
+    avanzarHasta(recibida + esperaNvs - periodoFondo - 1);
+    verificar(preferencias.getBytesLength(claveMezcla) == 0, "mezcla: nada se escribe antes de esperaNvs");
+    avanzarHasta(recibida + esperaNvs + 2 * periodoFondo);
+    ConfigMezcla guardada = {};
+    bool enNvs = preferencias.getBytesLength(claveMezcla) == sizeof(guardada) &&
+                 preferencias.getBytes(claveMezcla, &guardada, sizeof(guardada)) == sizeof(guardada);
+    verificar(enNvs && mezclaEs(guardada, nueva.expoAcelerador, nueva.expoGiro), "mezcla: se guarda en NVS");
+    configMezcla = ConfigMezcla{ 64, 96 };
+    cargarMezcla();
+    verificar(mezclaEs(configMezcla, nueva.expoAcelerador, nueva.expoGiro), "mezcla: al recargar de la NVS vuelve");
+}
+
+int main() {
+    iniciarFirmware();
+    SerialBT.conectar(true);
+    avanzar(2000);
+
+    const TablasCalibracion guardar = tablas(10);
+    const TablasCalibracion aplicar = tablas(-20);
+    const TablasCalibracion ultima = tablas(30);
+
+    // GUARDAR -> APLICAR -> 2 s -> recargar
+    preferencias.remove(claveCalibracion);
+    enviarTablas(guardar, CAL_GUARDAR);
+    uint32_t guardada = ms;
+    verificar(iguales(calibracion, guardar), "GUARDAR: los motores usan las tablas nuevas");
+    avanzar(500);
+    enviarTablas(aplicar, CAL_APLICAR);
+    verificar(iguales(calibracion, aplicar), "APLICAR: los motores usan las tablas de prueba");
+    avanzarHasta(guardada + esperaNvs - periodoFondo - 1);
+    verificar(preferencias.getBytesLength(claveCalibracion) == 0, "nada se escribe antes de esperaNvs");
+    avanzarHasta(guardada + esperaNvs + 2 * periodoFondo);
+    verificar(enNvs(guardar), "GUARDAR -> APLICAR -> 2 s: la NVS tiene las tablas de GUARDAR");
+    verificar(iguales(calibracion, aplicar), "las tablas de APLICAR siguen en uso hasta reiniciar");
+    cargarCalibracion();
+    verificar(iguales(calibracion, guardar), "al recargar de la NVS vuelven las tablas de GUARDAR");
+
+    // GUARDAR -> GUARDAR: gana la última
+    enviarTablas(aplicar, CAL_GUARDAR);
+    avanzar(300);
+    enviarTablas(ultima, CAL_GUARDAR);
+    avanzar(esperaNvs + 2 * periodoFondo);
+    verificar(enNvs(ultima), "GUARDAR -> GUARDAR: se guarda la ultima");
+
+    // GUARDAR -> RESTAURAR: se borra
+    enviarTablas(guardar, CAL_GUARDAR);
+    avanzar(300);
+    enviarFin(CAL_RESTAURAR);
+    avanzar(esperaNvs + 2 * periodoFondo);
+    verificar(preferencias.getBytesLength(claveCalibracion) == 0, "GUARDAR -> RESTAURAR: se borra la calibracion");
+
+    pruebaMezcla();
+
+    return terminarPrueba();
+}
@@ -0,0 +1,254 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba de ida y vuelta del protocolo binario
+
+  Descripción:
+  Codifica tramas con ProtocoloBinario.h y las decodifica byte a byte con
+  DecodificadorTramas y con ParserComandos, comprobando:
+  - Ida y vuelta: todos los largos 0..TRAMA_DATOS_MAX y todas las
+    combinaciones de duty de TRAMA_MANEJO y de TRAMA_ANALOGICO.
+  - CRC: cualquier bit invertido de una trama nunca da TRAMA_OK, y el
+    decodificador se recupera en la trama siguiente.
+  - Secuencia: repetidas y anteriores se descartan; el paso 255 -> 0 se
+    acepta; una nueva conexión (reiniciar) acepta cualquier secuencia.
+  - Largo: mayor que TRAMA_DATOS_MAX se rechaza al leerlo, y un largo
+    inválido para su tipo da ERR_TRAMA_TIPO.
+  - Flujo mixto: comandos ASCII, BYTE_VIDA y tramas intercalados salen en
+    orden y sin mezclarse.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaProtocolo PruebaProtocolo.cpp
+    ./PruebaProtocolo                 Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "ProtocoloBinario.h"
+#include "ParserComandos.h"
+#include "ArnesPruebas.h"
+
+// Alimenta 'largo' bytes y devuelve el resultado del último (o el primero que no sea INCOMPLETA)
+static ResultadoTrama decodificar(DecodificadorTramas& d, const uint8_t* bytes, size_t largo, Trama& t) {
+    for (size_t i = 0; i < largo; i++) {
+        ResultadoTrama r = d.alimentar(bytes[i], t);
+        if (r != TRAMA_INCOMPLETA) return i + 1 == largo ? r : TRAMA_ERROR_CRC; // Terminó antes de tiempo
+    }
+    return TRAMA_INCOMPLETA;
+}
+
+static void pruebaIdaYVuelta() {
+    DecodificadorTramas d;
+    uint8_t datos[TRAMA_DATOS_MAX], trama[TRAMA_LARGO_MAX];
+    uint8_t seq = 0;
+    bool bien = true;
+    for (uint16_t tipo = 0; tipo < 256 && bien; tipo += 37) {
+        for (uint8_t largo = 0; largo <= TRAMA_DATOS_MAX; largo++) {
+            for (uint8_t i = 0; i < largo; i++) datos[i] = (uint8_t)(tipo * 31 + largo * 7 + i * 13);
+            size_t n = codificarTrama((uint8_t)tipo, ++seq, datos, largo, trama);
+            Trama t = {};
+            if (n != (size_t)TRAMA_CABECERA + largo + 1 || decodificar(d, trama, n, t) != TRAMA_OK ||
+                t.tipo != tipo || t.largo != largo || t.seq != seq || memcmp(t.datos, datos, largo) != 0) {
+                bien = false;
+                break;
+            }
+        }
+    }
+    verificar(bien, "ida y vuelta: todos los largos 0..32");
+
+    // TRAMA_MANEJO completa, por el parser
+    ParserComandos parser;
+    Comando cmd = {};
+    bien = true;
+    for (int32_t d1 = -255; d1 <= 255 && bien; d1++) {
+        for (int32_t d2 = -255; d2 <= 255; d2++) {
+            size_t n = codificarManejo(++seq, (int16_t)d1, (int16_t)d2, trama);
+            bool listo = false;
+            for (size_t i = 0; i < n; i++) listo = parser.alimentar(trama[i], cmd);
+            if (!listo || cmd.tipo != CMD_MANEJO || cmd.duty1 != d1 || cmd.duty2 != d2) { bien = false; break; }
+        }
+    }
+    verificar(bien, "ida y vuelta: TRAMA_MANEJO con todos los duty -255..255");
+
+    bien = true;
+    for (int32_t a = -128; a <= 127 && bien; a++) {
+        for (int32_t g = -128; g <= 127; g++) {
+            size_t n = codificarAnalogico(++seq, (int8_t)a, (int8_t)g, trama);
+            bool listo = false;
+            for (size_t i = 0; i < n; i++) listo = parser.alimentar(trama[i], cmd);
+            if (!listo || cmd.tipo != CMD_ANALOGICO || cmd.acelerador != a || cmd.giro != g) { bien = false; break; }
+        }
+    }
+    verificar(bien, "ida y vuelta: TRAMA_ANALOGICO con todos los valores");
+
+    MuestraTelemetria m = {}, leida = {};
+    m.ms = 0x12345678;
+    for (uint8_t i = 0; i < 4; i++) m.duty[i] = (uint8_t)(i * 60 + 15);
+    for (uint8_t i = 0; i < 3; i++) m.velocidad[i] = (uint8_t)(250 - i);
+    m.periodoMaxUs = 1234;
+    m.colaRx = 56;
+    m.descartados = 7;
+    m.agrupados = 890;
+    m.msDesdeComando = 65535;
+    uint8_t bytesTelemetria[TRAMA_TELEMETRIA_BYTES];
+    size_t n = codificarTelemetria(200, m, bytesTelemetria);
+    Trama t = {};
+    DecodificadorTramas dt;
+    bien = n == TRAMA_TELEMETRIA_BYTES && decodificar(dt, bytesTelemetria, n, t) == TRAMA_OK && leerTelemetria(t, leida) &&
+           memcmp(&m, &leida, sizeof(m)) == 0;
+    verificar(bien, "ida y vuelta: MuestraTelemetria");
+}
+
+static void pruebaCrc() {
+    uint8_t datos[] = { 10, 0, 246, 255 };
+    uint8_t buena[TRAMA_LARGO_MAX], mala[TRAMA_LARGO_MAX], siguiente[TRAMA_LARGO_MAX];
+    size_t n = codificarTrama(TRAMA_MANEJO, 1, datos, sizeof(datos), buena);
+    bool nuncaOk = true, recupera = true;
+    uint8_t seq = 2;
+    // Todos los bits después de la sincronía (tipo, largo, seq, datos y CRC)
+    for (size_t byte = 1; byte < n; byte++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            DecodificadorTramas d;
+            memcpy(mala, buena, n);
+            mala[byte] ^= (uint8_t)(1 << bit);
+            Trama t = {};
+            for (size_t i = 0; i < n; i++) {
+                if (d.alimentar(mala[i], t) == TRAMA_OK) nuncaOk = false;
+            }
+            // Si el largo corrupto dejó la trama a medio recibir, la descarta la inactividad del enlace
+            if (d.enCurso()) d.descartar();
+            size_t m = codificarTrama(TRAMA_MANEJO, seq++, datos, sizeof(datos), siguiente);
+            if (decodificar(d, siguiente, m, t) != TRAMA_OK) recupera = false;
+        }
+    }
+    verificar(nuncaOk, "CRC: ningun bit invertido da una trama valida");
+    verificar(recupera, "CRC: la trama siguiente se decodifica");
+
+    ParserComandos parser;
+    Comando cmd = {};
+    memcpy(mala, buena, n);
+    mala[n - 1] ^= 0x01;
+    bool listo = false;
+    for (size_t i = 0; i < n; i++) listo = parser.alimentar(mala[i], cmd);
+    verificar(listo && cmd.tipo == CMD_ERROR && cmd.error == ERR_TRAMA_CRC, "CRC: el parser entrega ERR_TRAMA_CRC");
+}
+
+static void pruebaSecuencia() {
+    DecodificadorTramas d;
+    uint8_t trama[TRAMA_LARGO_MAX];
+    Trama t = {};
+    auto resultado = [&](uint8_t seq) {
+        size_t n = codificarTrama(TRAMA_VIGILANTE, seq, NULL, 0, trama);
+        return decodificar(d, trama, n, t);
+    };
+
+    verificar(resultado(250) == TRAMA_OK, "secuencia: la primera se acepta con cualquier valor");
+    verificar(resultado(250) == TRAMA_VIEJA, "secuencia: repetida se descarta");
+    verificar(resultado(249) == TRAMA_VIEJA, "secuencia: anterior se descarta");
+    bool vuelta = true;
+    for (uint16_t s = 251; s < 256 + 6; s++) vuelta = vuelta && resultado((uint8_t)s) == TRAMA_OK;
+    verificar(vuelta, "secuencia: 251..255 y luego 0..5 (vuelta) se aceptan");
+    verificar(resultado(255) == TRAMA_VIEJA, "secuencia: 255 despues de la vuelta es vieja");
+    verificar(resultado(5 + 127) == TRAMA_OK, "secuencia: salto de +127 se acepta");
+    verificar(resultado(5) == TRAMA_VIEJA, "secuencia: 127 atras (modulo 256) es vieja");
+    verificar(resultado(5 + 127) == TRAMA_VIEJA, "secuencia: la ultima aceptada repetida es vieja");
+    d.reiniciar();
+    verificar(resultado(3) == TRAMA_OK, "secuencia: tras reiniciar (nueva conexion) se acepta cualquiera");
+
+    ParserComandos parser;
+    Comando cmd = {};
+    size_t n = codificarManejo(9, 100, 100, trama);
+    for (size_t i = 0; i < n; i++) parser.alimentar(trama[i], cmd);
+    bool listo = false;
+    for (size_t i = 0; i < n; i++) listo = parser.alimentar(trama[i], cmd);
+    verificar(listo && cmd.tipo == CMD_ERROR && cmd.error == ERR_TRAMA_VIEJA, "secuencia: el parser entrega ERR_TRAMA_VIEJA");
+}
+
+static void pruebaLargo() {
+    uint8_t datos[TRAMA_DATOS_MAX + 1] = {};
+    uint8_t trama[TRAMA_LARGO_MAX + 1];
+    verificar(codificarTrama(TRAMA_MANEJO, 1, datos, TRAMA_DATOS_MAX + 1, trama) == 0,
+              "largo: codificarTrama rechaza mas de TRAMA_DATOS_MAX");
+
+    DecodificadorTramas d;
+    Trama t = {};
+    const uint8_t cabecera[] = { TRAMA_SYNC, TRAMA_MANEJO, TRAMA_DATOS_MAX + 1 };
+    verificar(d.alimentar(cabecera[0], t) == TRAMA_INCOMPLETA && d.alimentar(cabecera[1], t) == TRAMA_INCOMPLETA &&
+                  d.alimentar(cabecera[2], t) == TRAMA_ERROR_CRC && !d.enCurso(),
+              "largo: mayor que TRAMA_DATOS_MAX se rechaza al leer el largo");
+
+    ParserComandos parser;
+    Comando cmd = {};
+    const ErrorComando esperado[] = { ERR_TRAMA_TIPO, ERR_TRAMA_TIPO };
+    const uint8_t tipos[] = { TRAMA_MANEJO, TRAMA_ANALOGICO };
+    const uint8_t largos[] = { TRAMA_MANEJO_LARGO - 1, TRAMA_ANALOGICO_LARGO + 1 };
+    bool bien = true;
+    for (uint8_t i = 0; i < 2; i++) {
+        size_t n = codificarTrama(tipos[i], (uint8_t)(i + 1), datos, largos[i], trama);
+        bool listo = false;
+        for (size_t j = 0; j < n; j++) listo = parser.alimentar(trama[j], cmd);
+        bien = bien && listo && cmd.tipo == CMD_ERROR && cmd.error == esperado[i];
+    }
+    verificar(bien, "largo: invalido para el tipo da ERR_TRAMA_TIPO");
+}
+
+static void pruebaFlujoMixto() {
+    std::vector<uint8_t> flujo;
+    uint8_t trama[TRAMA_LARGO_MAX];
+    auto texto = [&](const char* s) { flujo.insert(flujo.end(), s, s + strlen(s)); };
+    auto agregar = [&](size_t n) { flujo.insert(flujo.end(), trama, trama + n); };
+
+    texto("U\n");
+    agregar(codificarManejo(1, -200, 200, trama));
+    texto("C1100\r\n");
+    flujo.push_back(BYTE_VIDA);
+    agregar(codificarAnalogico(2, 127, -127, trama));
+    agregar(codificarVigilante(3, 80, trama));
+    texto("  S\n");
+    agregar(codificarManejo(4, 0, 0, trama));
+    texto("MB\n");
+
+    const TipoComando esperados[] = { CMD_GENERAL, CMD_MANEJO, CMD_VELOCIDAD, CMD_VIDA, CMD_ANALOGICO,
+                                      CMD_TRAMA, CMD_GENERAL, CMD_MANEJO, CMD_METRICAS };
+    const size_t cantidad = sizeof(esperados) / sizeof(esperados[0]);
+    ParserComandos parser;
+    Comando cmd = {};
+    std::vector<Comando> recibidos;
+    for (uint8_t c : flujo) {
+        if (parser.alimentar(c, cmd)) recibidos.push_back(cmd);
+    }
+    bool bien = recibidos.size() == cantidad;
+    for (size_t i = 0; bien && i < cantidad; i++) bien = recibidos[i].tipo == esperados[i];
+    bien = bien && recibidos[0].letra == 'U' && recibidos[1].duty1 == -200 && recibidos[1].duty2 == 200 &&
+           recibidos[2].objetivo == '1' && recibidos[2].valor == 100 && recibidos[4].acelerador == 127 &&
+           recibidos[4].giro == -127 && recibidos[6].letra == 'S' && recibidos[8].objetivo == 'B';
+    verificar(bien, "flujo mixto: ASCII, BYTE_VIDA y tramas salen en orden");
+
+    // Una trama corrupta en medio no se lleva los comandos de texto que la siguen
+    flujo.clear();
+    size_t n = codificarManejo(5, 50, 50, trama);
+    trama[n - 1] ^= 0xFF;
+    agregar(n);
+    texto("D\n");
+    agregar(codificarManejo(6, 60, 60, trama));
+    recibidos.clear();
+    for (uint8_t c : flujo) {
+        if (parser.alimentar(c, cmd)) recibidos.push_back(cmd);
+    }
+    bien = recibidos.size() == 3 && recibidos[0].tipo == CMD_ERROR && recibidos[0].error == ERR_TRAMA_CRC &&
+           recibidos[1].tipo == CMD_GENERAL && recibidos[1].letra == 'D' && recibidos[2].tipo == CMD_MANEJO &&
+           recibidos[2].duty1 == 60;
+    verificar(bien, "flujo mixto: tras una trama corrupta siguen texto y tramas");
+}
+
+int main() {
+    pruebaIdaYVuelta();
+    pruebaCrc();
+    pruebaSecuencia();
+    pruebaLargo();
+    pruebaFlujoMixto();
+    return terminarPrueba();
+}
@@ -0,0 +1,138 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba de ráfagas de comandos (modo agrupado)
+
+  Descripción:
+  Compila principal.cpp contra la HAL de PC y, con reloj simulado, inyecta
+  en un mismo tick ráfagas de N movimientos (D, L, R, S... y al final U),
+  como las que encola la app cuando se mueve el joystick sin parar. Con el
+  robot detenido antes de cada ráfaga mide el tiempo desde la ráfaga (su
+  último comando) hasta la primera escritura PWM distinta de 0 (incluye los
+  ticks que tarda la rampa en salir de 0). Comprueba:
+  - Latencia constante: con agruparComandos la espera es la misma para
+    todas las N que caben en una pasada (bytesMaxPorPasada) y, más allá,
+    crece como mucho 1 ms por cada pasada extra.
+  - Nada viejo llega a los motores: solo se escriben los pines del último
+    movimiento (U) y comandosAgrupados suma N - 1.
+  Como contraste repite las ráfagas sin agrupar (un comando por pasada):
+  ahí la espera crece con N y los movimientos viejos sí se actúan.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaRafagas PruebaRafagas.cpp ../Codigos/principal.cpp
+    ./PruebaRafagas                   Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <set>
+#include <string>
+#include "ArnesPruebas.h"
+
+// principal.cpp
+extern bool agruparComandos;
+extern uint32_t comandosAgrupados;
+
+// Cada movimiento son 2 bytes: los últimos tamaños llenan justo una pasada, la pasan por un
+// comando y ocupan dos y cuatro pasadas (bytesMaxPorPasada de Configuracion.h)
+const uint32_t tamanos[] = { 1, 2, 5, 10, 20, 50, 100, 200, bytesMaxPorPasada / 2u, bytesMaxPorPasada / 2u + 1,
+                             bytesMaxPorPasada, 2u * bytesMaxPorPasada };
+
+struct Resultado {
+    uint32_t espera;          // ms hasta la primera escritura PWM (0 = en el mismo tick)
+    uint32_t pinesAjenos;     // Escrituras distintas de 0 en pines que U no usa
+    uint32_t agrupados;       // Aumento de comandosAgrupados
+};
+
+// Ráfaga de n movimientos con U al final, desde el robot detenido
+static Resultado rafaga(uint32_t n, const std::set<uint8_t>& pinesU) {
+    tick(std::string("S\n"));
+    avanzar(400); // Que la rampa llegue a 0 y la pantalla se calme
+
+    static const char* const viejos[] = { "D\n", "L\n", "R\n", "S\n" };
+    std::string datos;
+    for (uint32_t i = 0; i + 1 < n; i++) datos += viejos[i % 4];
+    datos += "U\n";
+
+    size_t desde = hal::registroPwm.size();
+    uint32_t agrupadosAntes = comandosAgrupados;
+    uint32_t inicio = ms + 1;
+    tick(datos);
+    Resultado r = { 0, 0, 0 };
+    bool llego = false;
+    for (uint32_t t = 0; t < n + 50 && !llego; t++) {
+        for (size_t i = desde; i < hal::registroPwm.size(); i++) {
+            const hal::EscrituraPwm& w = hal::registroPwm[i];
+            if (w.duty == 0) continue;
+            if (pinesU.count(w.pin) == 0) { r.pinesAjenos++; continue; }
+            if (!llego) {
+                r.espera = (uint32_t)(w.us / 1000) - inicio;
+                llego = true;
+            }
+        }
+        desde = hal::registroPwm.size();
+        if (!llego) tick();
+    }
+    if (!llego) r.espera = UINT32_MAX;
+    r.agrupados = comandosAgrupados - agrupadosAntes;
+    avanzar(n + 50); // Que termine de procesar (sin agrupar, un comando por ms)
+    return r;
+}
+
+int main() {
+    iniciarFirmware();
+    SerialBT.conectar(true);
+    avanzar(2000); // Animación de conexión
+
+    // Pines que mueve U solo (referencia)
+    tick(std::string("U\n"));
+    avanzar(100);
+    std::set<uint8_t> pinesU;
+    for (const auto& par : hal::dutyPwm) {
+        if (par.second != 0) pinesU.insert(par.first);
+    }
+    verificar(pinesU.size() == 2, "U mueve un pin por motor");
+
+    printf("\n%6s %6s %12s %12s %10s\n", "N", "bytes", "espera ms", "pines viejos", "agrupados");
+    uint32_t base = UINT32_MAX;
+    bool constante = true, acotada = true, sinViejos = true, cuenta = true;
+    for (uint32_t n : tamanos) {
+        Resultado r = rafaga(n, pinesU);
+        uint32_t bytes = 2 * n;
+        uint32_t pasadasExtra = (bytes - 1) / bytesMaxPorPasada;
+        printf("%6lu %6lu %12lu %12lu %10lu\n", (unsigned long)n, (unsigned long)bytes, (unsigned long)r.espera,
+               (unsigned long)r.pinesAjenos, (unsigned long)r.agrupados);
+        if (base == UINT32_MAX) base = r.espera;
+        if (pasadasExtra == 0 && r.espera != base) constante = false;
+        if (r.espera > base + pasadasExtra) acotada = false;
+        if (r.pinesAjenos != 0) sinViejos = false;
+        // Una pasada agrupa sus movimientos; cada pasada extra deja uno sin reemplazar
+        if (r.agrupados + 1 + pasadasExtra < n || r.agrupados > n - 1) cuenta = false;
+    }
+    char descripcion[128];
+    snprintf(descripcion, sizeof(descripcion), "agrupando: espera de %lu ms para toda rafaga de hasta %u bytes",
+             (unsigned long)base, (unsigned)bytesMaxPorPasada);
+    verificar(constante, descripcion);
+    verificar(acotada, "agrupando: mas alla, +1 ms como mucho por cada pasada extra");
+    verificar(sinViejos, "agrupando: ningun movimiento viejo llega a los motores");
+    verificar(cuenta, "agrupando: comandosAgrupados cuenta los movimientos reemplazados");
+
+    // Contraste: un comando por pasada
+    agruparComandos = false;
+    printf("\nSin agrupar:\n%6s %6s %12s %12s\n", "N", "bytes", "espera ms", "pines viejos");
+    uint32_t esperaMayor = 0, viejos = 0;
+    for (uint32_t n : tamanos) {
+        if (n > 200) break;
+        Resultado r = rafaga(n, pinesU);
+        printf("%6lu %6lu %12lu %12lu\n", (unsigned long)n, (unsigned long)(2 * n), (unsigned long)r.espera,
+               (unsigned long)r.pinesAjenos);
+        esperaMayor = r.espera;
+        viejos += r.pinesAjenos;
+    }
+    agruparComandos = true;
+    verificar(esperaMayor > base + 100 && viejos > 0,
+              "sin agrupar: la espera crece con N y se actuan movimientos viejos");
+
+    return terminarPrueba();
+}
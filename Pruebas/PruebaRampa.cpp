@@ -0,0 +1,141 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba de las rampas de velocidad
+
+  Descripción:
+  Recorre pasoRampa() (Rampa.h) tick a tick en los dos modos (solo
+  pendiente y trapezoidal) y con varias configuraciones, incluida la del
+  firmware. Comprueba en cada tick:
+  - Pendiente acotada: |cambio del valor| <= velMax.
+  - Aceleración acotada (trapezoidal): |cambio de la pendiente| <= acelMax,
+    también al llegar (la pendiente vuelve a 0 en el tick siguiente).
+  - Rango: el valor nunca sale de -255..255.
+  Y al final de cada caso:
+  - Convergencia exacta: el valor queda en el objetivo * 256 con pendiente
+    0 dentro de una cota de ticks, y se queda ahí.
+  - Sin sobrepaso si el objetivo no cambia (desde el reposo).
+  Casos: todos los pares inicio/objetivo desde el reposo con la
+  configuración del firmware, y una grilla con inversiones a mitad de
+  rampa (el objetivo cambia tras k ticks) para las demás.
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaRampa PruebaRampa.cpp
+    ./PruebaRampa                     Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Rampa.h"
+#include "ArnesPruebas.h"
+
+struct Resultado {
+    uint32_t casos = 0;
+    uint32_t pendienteExcedida = 0;
+    uint32_t aceleracionExcedida = 0;
+    uint32_t fueraDeRango = 0;
+    uint32_t sinConverger = 0;
+    uint32_t sobrepasos = 0;
+    uint32_t maxTicks = 0;                          // Desde el último cambio de objetivo
+    bool hayEjemplo = false;
+    int16_t ejemploInicio = 0, ejemploObjetivo = 0; // Primer caso que falló
+
+    bool bien() const { return pendienteExcedida + aceleracionExcedida + fueraDeRango + sinConverger + sobrepasos == 0; }
+};
+
+// Cota de ticks para converger desde cualquier estado: frenar, invertir y recorrer 2 * 255 a velMax
+static uint32_t cotaTicks(const ConfigRampa& c) {
+    uint32_t recorrido = (uint32_t)(2 * 255 * 256 / c.velMax) + 2;
+    uint32_t acelerar = c.acelMax > 0 ? (uint32_t)(c.velMax / c.acelMax + 1) : 0;
+    return recorrido + 4 * acelerar + 4;
+}
+
+// Inicio en reposo en 'inicio'; objetivo1 durante 'ticksAntes' ticks y luego objetivo2
+static void simular(const ConfigRampa& c, int16_t inicio, int16_t objetivo1, uint32_t ticksAntes, int16_t objetivo2,
+                    Resultado& r) {
+    EstadoRampa e = { (int32_t)inicio * 256, 0 };
+    uint32_t cota = ticksAntes + cotaTicks(c);
+    bool fallo = false;
+    bool haciaArriba = objetivo2 > inicio;
+    uint32_t llegada = 0;
+    for (uint32_t t = 0; t < cota + 50; t++) {
+        int16_t objetivo = t < ticksAntes ? objetivo1 : objetivo2;
+        EstadoRampa s = pasoRampa(e, objetivo, c);
+        int32_t paso = s.duty - e.duty;
+        if (abs(paso) > c.velMax) { r.pendienteExcedida++; fallo = true; }
+        if (c.acelMax > 0 && abs(s.vel - e.vel) > c.acelMax) { r.aceleracionExcedida++; fallo = true; }
+        if (s.duty < -255 * 256 || s.duty > 255 * 256) { r.fueraDeRango++; fallo = true; }
+        if (ticksAntes == 0 && inicio != objetivo2) {
+            // Objetivo fijo desde el reposo: avanza siempre hacia él, sin pasarlo
+            if (haciaArriba ? (paso < 0 || s.duty > objetivo2 * 256) : (paso > 0 || s.duty < objetivo2 * 256)) {
+                r.sobrepasos++;
+                fallo = true;
+            }
+        }
+        e = s;
+        bool enObjetivo = e.duty == (int32_t)objetivo2 * 256 && e.vel == 0;
+        if (t >= ticksAntes && enObjetivo && llegada == 0) llegada = t + 1;
+        if (t >= ticksAntes && !enObjetivo && llegada != 0) { llegada = 0; r.sinConverger++; fallo = true; } // Se fue
+    }
+    if (llegada == 0 || llegada > cota) { r.sinConverger++; fallo = true; }
+    if (llegada > ticksAntes && llegada - ticksAntes > r.maxTicks) r.maxTicks = llegada - ticksAntes;
+    if (fallo && !r.hayEjemplo) {
+        r.hayEjemplo = true;
+        r.ejemploInicio = inicio;
+        r.ejemploObjetivo = objetivo2;
+    }
+    r.casos++;
+}
+
+static void informar(const char* nombre, const ConfigRampa& c, const Resultado& r) {
+    char descripcion[160];
+    snprintf(descripcion, sizeof(descripcion),
+             "%s (velMax %ld, acelMax %ld): %lu casos, max %lu ticks (cota %lu)", nombre, (long)c.velMax,
+             (long)c.acelMax, (unsigned long)r.casos, (unsigned long)r.maxTicks, (unsigned long)cotaTicks(c));
+    verificar(r.bien(), descripcion);
+    if (!r.bien()) {
+        printf("      pendiente %lu, aceleracion %lu, rango %lu, convergencia %lu, sobrepaso %lu (p. ej. %d -> %d)\n",
+               (unsigned long)r.pendienteExcedida, (unsigned long)r.aceleracionExcedida, (unsigned long)r.fueraDeRango,
+               (unsigned long)r.sinConverger, (unsigned long)r.sobrepasos, r.ejemploInicio, r.ejemploObjetivo);
+    }
+}
+
+int main() {
+    // La del firmware: todos los pares inicio/objetivo desde el reposo
+    const ConfigRampa firmware = configurarRampa(150, 50, 1000);
+    Resultado r;
+    for (int16_t inicio = -255; inicio <= 255; inicio++) {
+        for (int16_t objetivo = -255; objetivo <= 255; objetivo++) simular(firmware, inicio, objetivo, 0, objetivo, r);
+    }
+    informar("firmware, todos los pares", firmware, r);
+
+    // Grilla con inversiones a mitad de rampa, en ambos modos
+    struct Caso { const char* nombre; ConfigRampa c; };
+    const Caso casos[] = {
+        { "firmware, inversiones", firmware },
+        { "solo pendiente 150 ms", configurarRampa(150, 0, 1000) },
+        { "solo pendiente 1 tick", configurarRampa(0, 0, 1000) },
+        { "trapezoidal 300/100 ms", configurarRampa(300, 100, 1000) },
+        { "trapezoidal 50/49 ms", configurarRampa(50, 49, 1000) },
+        { "trapezoidal 20/5 ms a 200 Hz", configurarRampa(20, 5, 200) },
+    };
+    const uint32_t ticksAntes[] = { 1, 3, 10, 25, 60 };
+    for (const Caso& caso : casos) {
+        Resultado g;
+        for (int16_t inicio = -255; inicio <= 255; inicio += 51) {
+            for (int16_t objetivo1 = -255; objetivo1 <= 255; objetivo1 += 17) {
+                for (uint32_t k : ticksAntes) {
+                    for (int16_t objetivo2 = -255; objetivo2 <= 255; objetivo2 += 85) {
+                        simular(caso.c, inicio, objetivo1, k, objetivo2, g);
+                    }
+                    simular(caso.c, inicio, objetivo1, k, (int16_t)-objetivo1, g); // Inversión completa
+                }
+            }
+        }
+        informar(caso.nombre, caso.c, g);
+    }
+
+    return terminarPrueba();
+}
@@ -0,0 +1,233 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba del registro diferido (anillo y formato)
+
+  Descripción:
+  Prueba Registro.h en el PC. Comprueba:
+  - Varios productores: cuatro hilos registran a la vez (como las tareas
+    en los dos núcleos del ESP32) y un hilo consumidor vacía el anillo.
+    Cada registro llega entero (id, enteros y texto coinciden), una sola
+    vez y en el orden de su productor. Dos pasadas: reintentando
+    AnilloRegistro::encolar() llegan todos; con Registro el anillo se
+    llena, y recibidos + perdidos() = enviados.
+  - Anillo lleno: los registros que no caben se descartan y se cuentan en
+    perdidos(); los guardados salen en orden y, al vaciarse, vuelve a
+    aceptar. El texto se corta en REGISTRO_TEXTO_MAX.
+  - Formato: %d, %u (el entero visto sin signo), %s y %%, con los enteros
+    en orden y 0 si el formato pide más de dos.
+  - Ids desconocidos (fuera de la tabla o sin formato): "? mensaje <id>".
+  - Truncado: con cualquier tamaño de buffer la salida es el comienzo de
+    la completa, termina en '\0' y el largo devuelto es el escrito.
+
+  Uso:
+    g++ -std=c++17 -O2 -pthread -I../Codigos -o PruebaRegistro PruebaRegistro.cpp
+    ./PruebaRegistro [miles]          Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ArnesPruebas.h"
+#include "Registro.h"
+
+const uint8_t PRODUCTORES = 4;
+
+static const char* const formatos[] = {
+    "Productor %u paso %u",
+    "Con signo %d, sin signo %u",
+    "RX: %s",
+    "100%% listo",
+    "Tres enteros %u %u %u",
+    NULL,
+};
+const uint8_t cantidadFormatos = sizeof(formatos) / sizeof(formatos[0]);
+
+static RegistroBinario crear(uint32_t ms, uint8_t mensaje, int32_t a, int32_t b, const char* texto) {
+    RegistroBinario r;
+    r.ms = ms;
+    r.mensaje = mensaje;
+    r.args[0] = a;
+    r.args[1] = b;
+    snprintf(r.texto, sizeof(r.texto), "%s", texto);
+    return r;
+}
+
+static void verificarFormato(const RegistroBinario& r, const char* esperado) {
+    char linea[96];
+    size_t largo = formatearRegistro(r, formatos, cantidadFormatos, linea, sizeof(linea));
+    char descripcion[160];
+    snprintf(descripcion, sizeof(descripcion), "formato: \"%s\"", esperado);
+    verificar(strcmp(linea, esperado) == 0 && largo == strlen(esperado), descripcion);
+    if (strcmp(linea, esperado) != 0) printf("      obtenido \"%s\"\n", linea);
+}
+
+// Comprueba lo que saca el consumidor: registros enteros, sin repetidos y en el orden de cada productor
+struct Consumidor {
+    int64_t ultimo[2 * PRODUCTORES];
+    uint64_t recibidos = 0;
+    bool enteros = true, enOrden = true;
+
+    Consumidor() {
+        for (int64_t& u : ultimo) u = -1;
+    }
+
+    void revisar(const RegistroBinario& r) {
+        recibidos++;
+        int64_t paso;
+        if (r.mensaje < PRODUCTORES) {
+            paso = r.args[0];
+            if (r.args[1] != ~r.args[0] || r.texto[0] != '\0') enteros = false;
+        } else if (r.mensaje < 2 * PRODUCTORES) {
+            unsigned id;
+            unsigned long i;
+            if (sscanf(r.texto, "p%u-%lu", &id, &i) != 2 || id + PRODUCTORES != r.mensaje || r.args[0] != 0) {
+                enteros = false;
+                return;
+            }
+            paso = (int64_t)i;
+        } else {
+            enteros = false;
+            return;
+        }
+        if (paso <= ultimo[r.mensaje]) enOrden = false;
+        ultimo[r.mensaje] = paso;
+    }
+};
+
+static RegistroBinario registroProductor(uint8_t id, uint32_t i, bool conTexto) {
+    char texto[REGISTRO_TEXTO_MAX + 1];
+    snprintf(texto, sizeof(texto), "p%u-%lu", id, (unsigned long)i);
+    return conTexto ? crear(i, id + PRODUCTORES, 0, 0, texto) : crear(i, id, (int32_t)i, ~(int32_t)i, "");
+}
+
+// Cuatro productores contra el consumidor (este hilo). sinPerdidas: el productor reintenta
+// AnilloRegistro::encolar() hasta que entra; si no, usa Registro, que descarta y cuenta.
+static void pruebaProductores(const char* nombre, uint32_t porProductor, bool sinPerdidas) {
+    static AnilloRegistro<64> anillo;
+    static Registro<64> registro;
+    std::atomic<uint8_t> terminados{0};
+    std::vector<std::thread> hilos;
+    for (uint8_t id = 0; id < PRODUCTORES; id++) {
+        hilos.emplace_back([&, id]() {
+            for (uint32_t i = 0; i < porProductor; i++) {
+                for (uint8_t conTexto = 0; conTexto < 2; conTexto++) {
+                    RegistroBinario r = registroProductor(id, i, conTexto);
+                    if (sinPerdidas) {
+                        while (!anillo.encolar(r)) std::this_thread::yield();
+                    } else if (conTexto) {
+                        registro.registrar(r.mensaje, r.texto);
+                    } else {
+                        registro.registrar(r.mensaje, r.args[0], r.args[1]);
+                    }
+                }
+                if (!sinPerdidas && i % 16 == 15) std::this_thread::yield(); // Que el consumidor alcance a sacar
+            }
+            terminados.fetch_add(1);
+        });
+    }
+
+    Consumidor c;
+    RegistroBinario r;
+    for (;;) {
+        bool fin = terminados.load() == PRODUCTORES;
+        while (sinPerdidas ? anillo.desencolar(r) : registro.extraer(r)) c.revisar(r);
+        if (fin) break;
+        std::this_thread::yield();
+    }
+    for (std::thread& h : hilos) h.join();
+
+    uint64_t enviados = (uint64_t)2 * PRODUCTORES * porProductor;
+    uint64_t perdidos = sinPerdidas ? 0 : registro.perdidos();
+    char descripcion[128];
+    printf("      %s: %llu enviados, %llu recibidos, %llu perdidos\n", nombre, (unsigned long long)enviados,
+           (unsigned long long)c.recibidos, (unsigned long long)perdidos);
+    snprintf(descripcion, sizeof(descripcion), "%s: cada registro llega entero (id, enteros y texto)", nombre);
+    verificar(c.enteros, descripcion);
+    snprintf(descripcion, sizeof(descripcion), "%s: sin repetidos y en el orden de cada productor", nombre);
+    verificar(c.enOrden, descripcion);
+    if (sinPerdidas) {
+        snprintf(descripcion, sizeof(descripcion), "%s: llegan todos", nombre);
+        verificar(c.recibidos == enviados, descripcion);
+    } else {
+        snprintf(descripcion, sizeof(descripcion), "%s: recibidos + perdidos() = enviados", nombre);
+        verificar(c.recibidos + perdidos == enviados && c.recibidos > 0, descripcion);
+    }
+}
+
+static void pruebaLleno() {
+    Registro<8> registro;
+    for (int32_t i = 0; i < 12; i++) registro.registrar(1, i, -i);
+    verificar(registro.perdidos() == 4, "lleno: 8 guardados y 4 contados en perdidos()");
+    RegistroBinario r;
+    int32_t esperado = 0;
+    bool enOrden = true;
+    while (registro.extraer(r)) {
+        if (r.args[0] != esperado || r.args[1] != -esperado) enOrden = false;
+        esperado++;
+    }
+    verificar(enOrden && esperado == 8, "lleno: salen los 8 primeros, en orden");
+    registro.registrar(2, "texto de diecisiete");
+    verificar(registro.extraer(r) && r.mensaje == 2 && registro.perdidos() == 4, "lleno: vaciado vuelve a aceptar");
+    verificar(strlen(r.texto) == REGISTRO_TEXTO_MAX && strncmp(r.texto, "texto de diecisiete", REGISTRO_TEXTO_MAX) == 0,
+              "lleno: el texto se corta en REGISTRO_TEXTO_MAX");
+}
+
+static void pruebaFormato() {
+    verificarFormato(crear(1234, 0, 3, 17, ""), "[1234] Productor 3 paso 17");
+    verificarFormato(crear(0, 1, -5, -1, ""), "[0] Con signo -5, sin signo 4294967295");
+    verificarFormato(crear(7, 2, 0, 0, "C1-12"), "[7] RX: C1-12");
+    verificarFormato(crear(7, 3, 0, 0, ""), "[7] 100% listo");
+    verificarFormato(crear(7, 4, 1, 2, ""), "[7] Tres enteros 1 2 0");
+    verificarFormato(crear(4294967295u, 0, 0, 0, ""), "[4294967295] Productor 0 paso 0");
+    // Desconocidos: sin formato en la tabla o fuera de ella
+    verificarFormato(crear(9, 5, 0, 0, ""), "[9] ? mensaje 5");
+    verificarFormato(crear(9, 99, 0, 0, ""), "[9] ? mensaje 99");
+}
+
+static void pruebaTruncado() {
+    const RegistroBinario casos[] = {
+        crear(123456, 1, -2147483647 - 1, 42, ""),
+        crear(5, 2, 0, 0, "texto largo"),
+        crear(5, 3, 0, 0, ""),
+        crear(5, 200, 0, 0, ""),
+    };
+    bool prefijo = true, terminado = true, largoBien = true, intacto = true;
+    for (const RegistroBinario& r : casos) {
+        char completa[96];
+        formatearRegistro(r, formatos, cantidadFormatos, completa, sizeof(completa));
+        for (size_t tamano = 0; tamano <= strlen(completa) + 1; tamano++) {
+            char salida[96 + 4];
+            memset(salida, '#', sizeof(salida));
+            size_t largo = formatearRegistro(r, formatos, cantidadFormatos, salida, tamano);
+            if (tamano == 0) {
+                if (largo != 0 || salida[0] != '#') intacto = false;
+                continue;
+            }
+            if (salida[largo] != '\0' || largo + 1 > tamano) terminado = false;
+            if (largo != strlen(salida)) largoBien = false;
+            if (strncmp(salida, completa, largo) != 0 || largo != (tamano - 1 < strlen(completa) ? tamano - 1 : strlen(completa)))
+                prefijo = false;
+            if (salida[tamano] != '#') intacto = false;
+        }
+    }
+    verificar(prefijo, "truncado: la salida es el comienzo de la completa, hasta tamano - 1");
+    verificar(terminado, "truncado: siempre termina en '\\0' dentro del buffer");
+    verificar(largoBien, "truncado: el largo devuelto es el escrito");
+    verificar(intacto, "truncado: no escribe fuera del buffer (tamano 0 no escribe)");
+}
+
+int main(int argc, char** argv) {
+    uint32_t miles = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+    pruebaProductores("productores sin perdidas", miles * 1000, true);
+    pruebaProductores("productores con anillo lleno", miles * 1000, false);
+    pruebaLleno();
+    pruebaFormato();
+    pruebaTruncado();
+    return terminarPrueba();
+}
@@ -0,0 +1,124 @@
+/*
+  ============================================================================
+  ROBÓTICA CODELAB SAS.
+
+  Proyecto: FUTBOT - Prueba del vigilante (deadman) con reloj simulado
+
+  Descripción:
+  Compila principal.cpp contra la HAL de PC y mide, tick a tick, el tiempo
+  desde el último alimento del vigilante hasta que los cuatro canales PWM
+  quedan en 0. Falla si pasa de timeout + 1 tick de control, con la tarea
+  de control corriendo o bloqueada (solo actúa la "ISR" del vigilante).
+  También cubre la carrera en que un comando llega en el mismo tick en que
+  el vigilante expira: el robot debe volver a responder a los comandos
+  siguientes (antes el PWM quedaba en 0 con el duty guardado distinto de 0).
+  Los canales y el timeout inicial son los del firmware (Configuracion.h).
+
+  Uso:
+    g++ -std=c++17 -O2 -I../Codigos -o PruebaVigilante PruebaVigilante.cpp ../Codigos/principal.cpp
+    ./PruebaVigilante                 Código 0 si todo pasa, 1 si algo falla
+  ============================================================================
+*/
+
+#include <stdio.h>
+#include "ArnesPruebas.h"
+#include "ParserComandos.h"
+#include "ProtocoloBinario.h"
+
+const uint32_t msTick = 1;
+
+// Los cuatro canales que vigila el firmware (pinesMotores de Configuracion.h)
+static bool pwmEnCero() {
+    for (uint8_t pin : pinesMotores) {
+        if (hal::dutyPwm[pin] != 0) return false;
+    }
+    return true;
+}
+
+// ms desde 'inicio' hasta que el PWM queda en 0 (o 'limite' si no pasa)
+static uint32_t esperarParada(uint32_t inicio, uint32_t limite, bool controlBloqueado) {
+    while (ms - inicio < limite) {
+        tick(NULL, 0, controlBloqueado);
+        if (pwmEnCero()) return ms - inicio;
+    }
+    return limite;
+}
+
+// Avanza enviando 'U' cada 'cada' ms (y BYTE_VIDA cada 'vida' ms si > 0) durante 'durante' ms
+static void manejar(uint32_t durante, uint32_t cada, uint32_t vida) {
+    uint32_t fin = ms + durante;
+    while (ms < fin) {
+        uint32_t siguiente = ms + 1;
+        if ((siguiente % cada) == 0) tickComando("U");
+        else if (vida > 0 && (siguiente % vida) == 0) tick(&BYTE_VIDA, 1);
+        else tick();
+    }
+}
+
+static void fijarTimeout(uint16_t timeoutMs) {
+    uint8_t trama[TRAMA_LARGO_MAX];
+    static uint8_t seq = 0;
+    size_t largo = codificarVigilante(seq++, timeoutMs, trama);
+    tick(trama, largo);
+}
+
+// fijar = false: sin TRAMA_VIGILANTE, con el timeout que tenga el firmware (timeoutMs)
+static void pruebaParada(const char* nombre, uint16_t timeoutMs, uint32_t vida, bool controlBloqueado,
+                         bool fijar = true) {
+    if (fijar) fijarTimeout(timeoutMs);
+    manejar(300, 100, vida);
+    verificar(!pwmEnCero(), "los motores giran antes de cortar el enlace");
+    // Último alimento: el comando U o BYTE_VIDA más reciente, ambos ya procesados
+    tickComando("U");
+    uint32_t inicio = ms;
+    uint32_t espera = esperarParada(inicio, 5000, controlBloqueado);
+    char descripcion[96];
+    snprintf(descripcion, sizeof(descripcion), "%s: parada en %lu ms (limite %lu)", nombre, (unsigned long)espera,
+             (unsigned long)(timeoutMs + msTick));
+    verificar(espera <= timeoutMs + msTick, descripcion);
+    avanzarHasta(ms + 2 * timeoutMs); // Que expire de nuevo estando parado
+}
+
+int main() {
+    iniciarFirmware();
+    SerialBT.conectar(true);
+    avanzarHasta(10);
+    verificar(hal::timeoutVigilanteUs == (uint64_t)timeoutVigilanteInicial * 1000,
+              "el vigilante arranca con timeoutVigilanteInicial");
+
+    const uint16_t inicial = timeoutVigilanteInicial;
+    pruebaParada("timeout inicial, control activo", inicial, 0, false, false);
+    pruebaParada("timeout inicial, control bloqueado", inicial, 0, true, false);
+    pruebaParada("timeout 50 con BYTE_VIDA, control activo", 50, 20, false);
+    pruebaParada("timeout 50 con BYTE_VIDA, control bloqueado", 50, 20, true);
+
+    // Carrera: un comando en el mismo tick de la expiración (U en 0, 0,7 T, 1,7 T y 1,7 T + 400 ms)
+    fijarTimeout(inicial);
+    uint32_t base = ms;
+    tickComando("U");
+    avanzarHasta(base + inicial * 7 / 10);
+    tickComando("U");
+    uint32_t ultimoAlimento = ms;
+    avanzarHasta(ultimoAlimento + inicial - msTick);
+    tickComando("U"); // El vigilante expira en este mismo tick
+    verificar(pwmEnCero(), "carrera: el vigilante detiene los motores aunque llegue un comando");
+    avanzarHasta(ms + 399);
+    tickComando("U");
+    ultimoAlimento = ms;
+    avanzarHasta(ms + 100);
+    verificar(!pwmEnCero(), "carrera: el comando siguiente vuelve a mover los motores");
+    uint32_t espera = esperarParada(ultimoAlimento, 5000, false);
+    verificar(espera <= inicial + msTick, "carrera: el vigilante vuelve a detener a tiempo");
+
+    // Carrera estando parado: la expiración que se repite sin alimento no se come el comando
+    avanzarHasta(ms + 100);
+    uint32_t expiracion = (uint32_t)((hal::ultimoAlimentoUs + hal::timeoutVigilanteUs) / 1000);
+    size_t disparos = hal::disparosVigilante.size();
+    avanzarHasta(expiracion - 1);
+    tickComando("U");
+    verificar(hal::disparosVigilante.size() > disparos, "carrera en reposo: el comando llega con la expiracion");
+    avanzarHasta(ms + 100);
+    verificar(!pwmEnCero(), "carrera en reposo: el comando mueve los motores");
+
+    return terminarPrueba();
+}